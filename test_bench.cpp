@@ -0,0 +1,722 @@
+﻿/**
+ * @file test_bench.cpp
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ * 
+ * @author  : Gaaagaa
+ * @date    : 2026-10-19
+ * @version : 1.0.0.0
+ * @brief   : INI 的 性能测试 程序（加载、索引、类型转换、输出、内存），结果以 JSON 格式输出。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "xini_file.h"
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else // !_WIN32
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif // _WIN32
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @struct xbench_conf_t
+ * @brief  测试参数（相同的参数 生成相同的测试数据，便于不同版本之间比较）。
+ */
+struct xbench_conf_t
+{
+    unsigned int m_xut_seed;      ///< 生成测试数据的随机种子
+    size_t       m_xst_small;     ///< 小文件 的字节数
+    size_t       m_xst_medium;    ///< 中等文件 的字节数（同时用于 索引、类型转换 的测试）
+    size_t       m_xst_huge;      ///< 大文件 的字节数
+    size_t       m_xst_volume;    ///< 每项加载测试 累计处理的字节数（决定重复次数）
+    size_t       m_xst_repeat;    ///< 最少重复次数
+    std::string  m_xstr_dir;      ///< 临时文件所在目录
+    std::string  m_xstr_json;     ///< JSON 输出文件（为空时 输出到 stdout）
+};
+
+/**
+ * @struct xbench_key_t
+ * @brief  测试数据中的 键（分节名 + 键名）。
+ */
+struct xbench_key_t
+{
+    std::string m_xstr_sect;
+    std::string m_xstr_key;
+};
+
+typedef std::vector< xbench_key_t > xvec_key_t;
+typedef std::vector< double >       xvec_time_t;
+
+/**
+ * @struct xbench_stat_t
+ * @brief  多次测量 的统计结果（秒）。
+ */
+struct xbench_stat_t
+{
+    double m_xdt_best;
+    double m_xdt_median;
+};
+
+/** 防止被测操作 因结果未使用而被编译器优化掉 */
+static volatile size_t g_xst_sink = 0;
+
+/**********************************************************/
+/**
+ * @brief 单调时钟（秒）。
+ */
+static double bench_now(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER xfreq;
+    LARGE_INTEGER xtick;
+    QueryPerformanceFrequency(&xfreq);
+    QueryPerformanceCounter(&xtick);
+    return (static_cast< double >(xtick.QuadPart) / static_cast< double >(xfreq.QuadPart));
+#else // !_WIN32
+    struct timespec xtime;
+    clock_gettime(CLOCK_MONOTONIC, &xtime);
+    return (static_cast< double >(xtime.tv_sec) + 1.0e-9 * static_cast< double >(xtime.tv_nsec));
+#endif // _WIN32
+}
+
+/**********************************************************/
+/**
+ * @brief 进程的 内存占用峰值（字节）。
+ */
+static size_t bench_peak_rss(void)
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS xpmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &xpmc, sizeof(xpmc)))
+        return static_cast< size_t >(xpmc.PeakWorkingSetSize);
+    return 0;
+#else // !_WIN32
+    struct rusage xusage;
+    if (0 != getrusage(RUSAGE_SELF, &xusage))
+        return 0;
+#ifdef __APPLE__
+    return static_cast< size_t >(xusage.ru_maxrss);
+#else // !__APPLE__
+    return static_cast< size_t >(xusage.ru_maxrss) * 1024;
+#endif // __APPLE__
+#endif // _WIN32
+}
+
+/**********************************************************/
+/**
+ * @brief 线性同余 伪随机数（与平台的 rand() 无关，保证测试数据可复现）。
+ */
+static unsigned int bench_rand(unsigned int & xut_seed)
+{
+    xut_seed = xut_seed * 1103515245U + 12345U;
+    return ((xut_seed >> 16) & 0x7FFF);
+}
+
+/**********************************************************/
+/**
+ * @brief 统计多次测量的 最优值 与 中位数。
+ */
+static xbench_stat_t bench_stat(xvec_time_t xvec_time)
+{
+    xbench_stat_t xstat = { 0.0, 0.0 };
+    if (xvec_time.empty())
+        return xstat;
+
+    std::sort(xvec_time.begin(), xvec_time.end());
+    xstat.m_xdt_best   = xvec_time.front();
+    xstat.m_xdt_median = xvec_time[xvec_time.size() / 2];
+    return xstat;
+}
+
+/**********************************************************/
+/**
+ * @brief 生成测试用的 INI 文本。
+ * 
+ * @param [in ] xst_bytes : 文本的大致字节数。
+ * @param [in ] xut_seed  : 随机种子。
+ * @param [out] xvec_key  : 返回 文本中的各个 键。
+ */
+static std::string bench_text(size_t xst_bytes, unsigned int xut_seed, xvec_key_t & xvec_key)
+{
+    static const char * const xszt_words[] =
+    {
+        "alpha", "bravo", "charlie", "delta", "echo", "foxtrot",
+        "golf", "hotel", "india", "juliet", "kilo", "lima"
+    };
+
+    std::string xstr_text;
+    xstr_text.reserve(xst_bytes + 256);
+    xvec_key.clear();
+
+    char xszt_line[256];
+
+    for (unsigned int xut_sect = 0; xstr_text.size() < xst_bytes; ++xut_sect)
+    {
+        if (0 == (xut_sect % 4))
+        {
+            snprintf(xszt_line, sizeof(xszt_line), "; section group %u\n", xut_sect / 4);
+            xstr_text += xszt_line;
+        }
+
+        snprintf(xszt_line, sizeof(xszt_line), "[section_%05u]\n", xut_sect);
+        xstr_text += xszt_line;
+
+        std::string xstr_sect(xszt_line + 1, strlen(xszt_line) - 3);
+
+        unsigned int xut_keys = 4 + bench_rand(xut_seed) % 12;
+        for (unsigned int xut_key = 0; xut_key < xut_keys; ++xut_key)
+        {
+            unsigned int xut_rand = bench_rand(xut_seed);
+
+            xbench_key_t xkey;
+            xkey.m_xstr_sect = xstr_sect;
+
+            switch (xut_key % 4)
+            {
+            case 0:
+                snprintf(xszt_line, sizeof(xszt_line), "int_%u", xut_key);
+                xkey.m_xstr_key = xszt_line;
+                snprintf(xszt_line, sizeof(xszt_line), "%s=%u\n", xkey.m_xstr_key.c_str(), xut_rand);
+                break;
+            case 1:
+                snprintf(xszt_line, sizeof(xszt_line), "real_%u", xut_key);
+                xkey.m_xstr_key = xszt_line;
+                snprintf(xszt_line, sizeof(xszt_line), "%s=%u.%03u\n", xkey.m_xstr_key.c_str(), xut_rand, xut_rand % 1000);
+                break;
+            case 2:
+                snprintf(xszt_line, sizeof(xszt_line), "flag_%u", xut_key);
+                xkey.m_xstr_key = xszt_line;
+                snprintf(xszt_line, sizeof(xszt_line), "%s = %s\n", xkey.m_xstr_key.c_str(), (xut_rand & 1) ? "true" : "false");
+                break;
+            default:
+                snprintf(xszt_line, sizeof(xszt_line), "%s_name_%u", xszt_words[xut_rand % 12], xut_key);
+                xkey.m_xstr_key = xszt_line;
+                snprintf(xszt_line, sizeof(xszt_line), "%s=%s %s %u ; note\n",
+                         xkey.m_xstr_key.c_str(),
+                         xszt_words[(xut_rand >> 4) % 12],
+                         xszt_words[(xut_rand >> 8) % 12],
+                         xut_rand);
+                break;
+            }
+
+            xstr_text += xszt_line;
+            xvec_key.push_back(xkey);
+        }
+
+        xstr_text += "\n";
+    }
+
+    return xstr_text;
+}
+
+/**********************************************************/
+/**
+ * @brief 将文本写入文件。
+ */
+static bool bench_write(const std::string & xstr_path, const std::string & xstr_text)
+{
+    std::ofstream xofs(xstr_path.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    xofs.write(xstr_text.data(), static_cast< std::streamsize >(xstr_text.size()));
+    return xofs.good();
+}
+
+/**********************************************************/
+/**
+ * @brief 文件的字节数。
+ */
+static size_t bench_fsize(const std::string & xstr_path)
+{
+    struct stat xstat;
+    if (0 != stat(xstr_path.c_str(), &xstat))
+        return 0;
+    return static_cast< size_t >(xstat.st_size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// JSON 输出
+
+/**
+ * @class xbench_json_t
+ * @brief 简单的 JSON 输出（只支持本程序用到的 对象、数值、字符串）。
+ */
+class xbench_json_t
+{
+public:
+    xbench_json_t(void) : m_xbt_first(true), m_xst_depth(0) { }
+
+    void open(const char * xszt_name = NULL)
+    {
+        field(xszt_name);
+        m_xstr_text += "{";
+        m_xbt_first = true;
+        ++m_xst_depth;
+    }
+
+    void close(void)
+    {
+        --m_xst_depth;
+        m_xstr_text += "\n" + std::string(m_xst_depth * 2, ' ') + "}";
+        m_xbt_first = false;
+    }
+
+    void number(const char * xszt_name, double xdt_value)
+    {
+        char xszt_value[64];
+        snprintf(xszt_value, sizeof(xszt_value), "%.6g", xdt_value);
+        field(xszt_name);
+        m_xstr_text += xszt_value;
+    }
+
+    void number(const char * xszt_name, size_t xst_value)
+    {
+        char xszt_value[64];
+        snprintf(xszt_value, sizeof(xszt_value), "%lu", static_cast< unsigned long >(xst_value));
+        field(xszt_name);
+        m_xstr_text += xszt_value;
+    }
+
+    void string(const char * xszt_name, const std::string & xstr_value)
+    {
+        field(xszt_name);
+        m_xstr_text += '"';
+        for (size_t xst_iter = 0; xst_iter < xstr_value.size(); ++xst_iter)
+        {
+            char xchar = xstr_value[xst_iter];
+            if (('"' == xchar) || ('\\' == xchar))
+                m_xstr_text += '\\';
+            if (static_cast< unsigned char >(xchar) >= 0x20)
+                m_xstr_text += xchar;
+        }
+        m_xstr_text += '"';
+    }
+
+    void stat(const char * xszt_name, const xbench_stat_t & xstat)
+    {
+        open(xszt_name);
+        number("best_s"  , xstat.m_xdt_best  );
+        number("median_s", xstat.m_xdt_median);
+        close();
+    }
+
+    const std::string & text(void) const { return m_xstr_text; }
+
+private:
+    void field(const char * xszt_name)
+    {
+        if (0 == m_xst_depth)
+            return;
+        m_xstr_text += m_xbt_first ? "\n" : ",\n";
+        m_xstr_text += std::string(m_xst_depth * 2, ' ');
+        m_xbt_first = false;
+        if (NULL != xszt_name)
+        {
+            m_xstr_text += '"';
+            m_xstr_text += xszt_name;
+            m_xstr_text += "\": ";
+        }
+    }
+
+private:
+    std::string m_xstr_text;
+    bool        m_xbt_first;
+    size_t      m_xst_depth;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// 各项测试
+
+/**********************************************************/
+/**
+ * @brief 加载吞吐量（load() 从磁盘文件 解析 并建立索引）。
+ */
+static void bench_load(xbench_json_t & xjson,
+                       const xbench_conf_t & xconf,
+                       const char * xszt_name,
+                       size_t xst_bytes)
+{
+    xvec_key_t  xvec_key;
+    std::string xstr_text = bench_text(xst_bytes, xconf.m_xut_seed, xvec_key);
+    std::string xstr_path = xconf.m_xstr_dir + "/xini_bench_" + xszt_name + ".ini";
+    bench_write(xstr_path, xstr_text);
+
+    size_t xst_repeat = xconf.m_xst_volume / xstr_text.size();
+    if (xst_repeat < xconf.m_xst_repeat)
+        xst_repeat = xconf.m_xst_repeat;
+
+    std::cerr << "load " << xszt_name << " : " << xstr_text.size()
+              << " bytes x " << xst_repeat << std::endl;
+
+    xvec_time_t   xvec_time;
+    xini_memory_t xmem;
+
+    for (size_t xst_iter = 0; xst_iter < xst_repeat; ++xst_iter)
+    {
+        xini_file_t xfile;
+
+        double xdt_begin = bench_now();
+        xfile.load(xstr_path);
+        xvec_time.push_back(bench_now() - xdt_begin);
+
+        if (0 == xst_iter)
+            xmem = xfile.memory_usage();
+        g_xst_sink += xfile.sect_count();
+    }
+
+    xbench_stat_t xstat = bench_stat(xvec_time);
+
+    xjson.open(xszt_name);
+    xjson.number("bytes"        , xstr_text.size());
+    xjson.number("keys"         , xvec_key.size());
+    xjson.number("repeat"       , xst_repeat);
+    xjson.stat  ("time"         , xstat);
+    xjson.number("mb_per_s"     , xstr_text.size() / (1024.0 * 1024.0) / xstat.m_xdt_median);
+    xjson.number("memory_bytes" , xmem.total());
+    xjson.number("memory_ratio" , static_cast< double >(xmem.total()) / xstr_text.size());
+    xjson.close();
+
+    remove(xstr_path.c_str());
+}
+
+/**********************************************************/
+/**
+ * @brief 索引延迟（const operator []）：
+ *        cold - 加载后 按随机次序 逐个访问全部键（每个键只访问一次）；
+ *        warm - 反复访问 少量 固定的键（数据已在缓存中）。
+ */
+static void bench_lookup(xbench_json_t & xjson, const xbench_conf_t & xconf)
+{
+    xvec_key_t  xvec_key;
+    std::string xstr_text = bench_text(xconf.m_xst_medium, xconf.m_xut_seed, xvec_key);
+
+    // 随机次序（Fisher–Yates）
+    xvec_key_t xvec_cold = xvec_key;
+    unsigned int xut_seed = xconf.m_xut_seed;
+    for (size_t xst_iter = xvec_cold.size(); xst_iter > 1; --xst_iter)
+    {
+        size_t xst_pick = ((static_cast< size_t >(bench_rand(xut_seed)) << 15) | bench_rand(xut_seed)) % xst_iter;
+        std::swap(xvec_cold[xst_iter - 1], xvec_cold[xst_pick]);
+    }
+
+    xvec_time_t xvec_cold_ns;
+    xvec_time_t xvec_warm_ns;
+    xvec_time_t xvec_miss_ns;
+
+    const size_t xst_warm = (xvec_cold.size() < 64) ? xvec_cold.size() : 64;
+    const size_t xst_loop = 200000;
+
+    for (size_t xst_iter = 0; xst_iter < xconf.m_xst_repeat; ++xst_iter)
+    {
+        xini_file_t xfile;
+        std::istringstream xstr_istr(xstr_text);
+        xfile << xstr_istr;
+        xfile.set_dirty(false);
+
+        const xini_file_t & xcfile = xfile;
+
+        double xdt_begin = bench_now();
+        for (size_t xst_jter = 0; xst_jter < xvec_cold.size(); ++xst_jter)
+        {
+            const xbench_key_t & xkey = xvec_cold[xst_jter];
+            g_xst_sink += xcfile[xkey.m_xstr_sect][xkey.m_xstr_key].value().size();
+        }
+        xvec_cold_ns.push_back((bench_now() - xdt_begin) * 1.0e9 / xvec_cold.size());
+
+        xdt_begin = bench_now();
+        for (size_t xst_jter = 0; xst_jter < xst_loop; ++xst_jter)
+        {
+            const xbench_key_t & xkey = xvec_cold[xst_jter % xst_warm];
+            g_xst_sink += xcfile[xkey.m_xstr_sect][xkey.m_xstr_key].value().size();
+        }
+        xvec_warm_ns.push_back((bench_now() - xdt_begin) * 1.0e9 / xst_loop);
+
+        xdt_begin = bench_now();
+        for (size_t xst_jter = 0; xst_jter < xst_loop; ++xst_jter)
+        {
+            const xbench_key_t & xkey = xvec_cold[xst_jter % xst_warm];
+            g_xst_sink += xcfile[xkey.m_xstr_sect]["missing_key"].value().size();
+        }
+        xvec_miss_ns.push_back((bench_now() - xdt_begin) * 1.0e9 / xst_loop);
+    }
+
+    std::cerr << "lookup : " << xvec_key.size() << " keys" << std::endl;
+
+    xjson.open("lookup");
+    xjson.number("keys"     , xvec_key.size());
+    xjson.number("cold_ns"  , bench_stat(xvec_cold_ns).m_xdt_median);
+    xjson.number("warm_ns"  , bench_stat(xvec_warm_ns).m_xdt_median);
+    xjson.number("miss_ns"  , bench_stat(xvec_miss_ns).m_xdt_median);
+    xjson.close();
+}
+
+/**********************************************************/
+/**
+ * @brief 类型转换 的开销（只计 键值节点 上的读/写，不含索引）。
+ */
+static void bench_convert(xbench_json_t & xjson, const xbench_conf_t & xconf)
+{
+    xvec_key_t  xvec_key;
+    std::string xstr_text = bench_text(xconf.m_xst_medium, xconf.m_xut_seed, xvec_key);
+
+    xini_file_t xfile;
+    std::istringstream xstr_istr(xstr_text);
+    xfile << xstr_istr;
+
+    // 按类型 收集键值节点（int_*、real_*、flag_* 分别为 整数、浮点数、布尔值）
+    std::vector< xini_keyvalue_t * > xvec_int;
+    std::vector< xini_keyvalue_t * > xvec_real;
+    std::vector< xini_keyvalue_t * > xvec_flag;
+    for (size_t xst_iter = 0; xst_iter < xvec_key.size(); ++xst_iter)
+    {
+        const xbench_key_t & xkey = xvec_key[xst_iter];
+        xini_keyvalue_t * xndkv_ptr = &xfile[xkey.m_xstr_sect][xkey.m_xstr_key];
+        switch (xkey.m_xstr_key[0])
+        {
+        case 'i': xvec_int .push_back(xndkv_ptr); break;
+        case 'r': xvec_real.push_back(xndkv_ptr); break;
+        case 'f': xvec_flag.push_back(xndkv_ptr); break;
+        default : break;
+        }
+    }
+
+    xvec_time_t xvec_time[6];
+
+    for (size_t xst_iter = 0; xst_iter < xconf.m_xst_repeat; ++xst_iter)
+    {
+        double xdt_begin = bench_now();
+        for (size_t xst_jter = 0; xst_jter < xvec_int.size(); ++xst_jter)
+            g_xst_sink += static_cast< int >(*xvec_int[xst_jter]);
+        xvec_time[0].push_back((bench_now() - xdt_begin) * 1.0e9 / xvec_int.size());
+
+        xdt_begin = bench_now();
+        for (size_t xst_jter = 0; xst_jter < xvec_real.size(); ++xst_jter)
+            g_xst_sink += static_cast< size_t >(static_cast< double >(*xvec_real[xst_jter]));
+        xvec_time[1].push_back((bench_now() - xdt_begin) * 1.0e9 / xvec_real.size());
+
+        xdt_begin = bench_now();
+        for (size_t xst_jter = 0; xst_jter < xvec_flag.size(); ++xst_jter)
+            g_xst_sink += static_cast< bool >(*xvec_flag[xst_jter]) ? 1 : 0;
+        xvec_time[2].push_back((bench_now() - xdt_begin) * 1.0e9 / xvec_flag.size());
+
+        xdt_begin = bench_now();
+        for (size_t xst_jter = 0; xst_jter < xvec_int.size(); ++xst_jter)
+            *xvec_int[xst_jter] = static_cast< int >(xst_jter + xst_iter);
+        xvec_time[3].push_back((bench_now() - xdt_begin) * 1.0e9 / xvec_int.size());
+
+        xdt_begin = bench_now();
+        for (size_t xst_jter = 0; xst_jter < xvec_real.size(); ++xst_jter)
+            *xvec_real[xst_jter] = 0.5 * static_cast< double >(xst_jter + xst_iter);
+        xvec_time[4].push_back((bench_now() - xdt_begin) * 1.0e9 / xvec_real.size());
+
+        xdt_begin = bench_now();
+        for (size_t xst_jter = 0; xst_jter < xvec_flag.size(); ++xst_jter)
+            *xvec_flag[xst_jter] = (0 != ((xst_jter + xst_iter) & 1));
+        xvec_time[5].push_back((bench_now() - xdt_begin) * 1.0e9 / xvec_flag.size());
+    }
+
+    xfile.set_dirty(false);
+
+    std::cerr << "convert : " << xvec_int.size() << " int, "
+              << xvec_real.size() << " real, "
+              << xvec_flag.size() << " bool" << std::endl;
+
+    xjson.open("convert");
+    xjson.number("get_int_ns"   , bench_stat(xvec_time[0]).m_xdt_median);
+    xjson.number("get_double_ns", bench_stat(xvec_time[1]).m_xdt_median);
+    xjson.number("get_bool_ns"  , bench_stat(xvec_time[2]).m_xdt_median);
+    xjson.number("set_int_ns"   , bench_stat(xvec_time[3]).m_xdt_median);
+    xjson.number("set_double_ns", bench_stat(xvec_time[4]).m_xdt_median);
+    xjson.number("set_bool_ns"  , bench_stat(xvec_time[5]).m_xdt_median);
+    xjson.close();
+}
+
+/**********************************************************/
+/**
+ * @brief 输出吞吐量（dump() 写入磁盘文件）。
+ */
+static void bench_dump(xbench_json_t & xjson,
+                       const xbench_conf_t & xconf,
+                       const char * xszt_name,
+                       size_t xst_bytes)
+{
+    xvec_key_t  xvec_key;
+    std::string xstr_text = bench_text(xst_bytes, xconf.m_xut_seed, xvec_key);
+    std::string xstr_path = xconf.m_xstr_dir + "/xini_bench_dump_" + xszt_name + ".ini";
+
+    xini_file_t xfile;
+    std::istringstream xstr_istr(xstr_text);
+    xfile << xstr_istr;
+    xfile.set_dirty(false);
+
+    size_t xst_repeat = xconf.m_xst_volume / xstr_text.size();
+    if (xst_repeat < xconf.m_xst_repeat)
+        xst_repeat = xconf.m_xst_repeat;
+
+    std::cerr << "dump " << xszt_name << " : " << xstr_text.size()
+              << " bytes x " << xst_repeat << std::endl;
+
+    xvec_time_t xvec_time;
+    for (size_t xst_iter = 0; xst_iter < xst_repeat; ++xst_iter)
+    {
+        double xdt_begin = bench_now();
+        xfile.dump(xstr_path);
+        xvec_time.push_back(bench_now() - xdt_begin);
+    }
+
+    size_t xst_fsize = bench_fsize(xstr_path);
+    xbench_stat_t xstat = bench_stat(xvec_time);
+
+    xjson.open(xszt_name);
+    xjson.number("bytes"   , xst_fsize);
+    xjson.number("repeat"  , xst_repeat);
+    xjson.stat  ("time"    , xstat);
+    xjson.number("mb_per_s", xst_fsize / (1024.0 * 1024.0) / xstat.m_xdt_median);
+    xjson.close();
+
+    remove(xstr_path.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**********************************************************/
+/**
+ * @brief 测试程序的入口 main() 函数。
+ */
+int main(int argc, char * argv[])
+{
+    xbench_conf_t xconf;
+    xconf.m_xut_seed   = 20261019;
+    xconf.m_xst_small  = 4 * 1024;
+    xconf.m_xst_medium = 1024 * 1024;
+    xconf.m_xst_huge   = 16 * 1024 * 1024;
+    xconf.m_xst_volume = 64 * 1024 * 1024;
+    xconf.m_xst_repeat = 5;
+    xconf.m_xstr_dir   = ".";
+
+    for (int xit_iter = 1; xit_iter < argc; ++xit_iter)
+    {
+        std::string xstr_arg = argv[xit_iter];
+        if (("-o" == xstr_arg) && (xit_iter + 1 < argc))
+        {
+            xconf.m_xstr_json = argv[++xit_iter];
+        }
+        else if (("-d" == xstr_arg) && (xit_iter + 1 < argc))
+        {
+            xconf.m_xstr_dir = argv[++xit_iter];
+        }
+        else if (("-s" == xstr_arg) && (xit_iter + 1 < argc))
+        {
+            xconf.m_xut_seed = static_cast< unsigned int >(strtoul(argv[++xit_iter], NULL, 10));
+        }
+        else if ("-q" == xstr_arg)
+        {
+            // 快速模式：缩小 大文件 与 累计处理量，用于冒烟测试
+            xconf.m_xst_huge   = 4 * 1024 * 1024;
+            xconf.m_xst_volume = 8 * 1024 * 1024;
+            xconf.m_xst_repeat = 3;
+        }
+        else
+        {
+            std::cout << "usage : "
+                      << argv[0]
+                      << " [ -o < json file > ] [ -d < temp dir > ] [ -s < seed > ] [ -q ]"
+                      << std::endl;
+            return -1;
+        }
+    }
+
+#if !defined(NDEBUG) || (defined(__GNUC__) && !defined(__OPTIMIZE__))
+    std::cerr << "warning : not an optimized build, results are not comparable." << std::endl;
+#endif
+
+    //======================================
+
+    xbench_json_t xjson;
+    xjson.open();
+
+    xjson.open("config");
+    xjson.number("seed"        , static_cast< size_t >(xconf.m_xut_seed));
+    xjson.number("small_bytes" , xconf.m_xst_small );
+    xjson.number("medium_bytes", xconf.m_xst_medium);
+    xjson.number("huge_bytes"  , xconf.m_xst_huge  );
+    xjson.number("volume_bytes", xconf.m_xst_volume);
+    xjson.number("min_repeat"  , xconf.m_xst_repeat);
+    xjson.number("cplusplus"   , static_cast< size_t >(__cplusplus));
+#ifdef __VERSION__
+    xjson.string("compiler"    , __VERSION__);
+#endif
+#ifdef NDEBUG
+    xjson.number("ndebug"      , static_cast< size_t >(1));
+#else
+    xjson.number("ndebug"      , static_cast< size_t >(0));
+#endif
+    xjson.close();
+
+    xjson.open("load");
+    bench_load(xjson, xconf, "small" , xconf.m_xst_small );
+    bench_load(xjson, xconf, "medium", xconf.m_xst_medium);
+    bench_load(xjson, xconf, "huge"  , xconf.m_xst_huge  );
+    xjson.close();
+
+    bench_lookup (xjson, xconf);
+    bench_convert(xjson, xconf);
+
+    xjson.open("dump");
+    bench_dump(xjson, xconf, "medium", xconf.m_xst_medium);
+    bench_dump(xjson, xconf, "huge"  , xconf.m_xst_huge  );
+    xjson.close();
+
+    xjson.open("memory");
+    xjson.number("peak_rss_bytes", bench_peak_rss());
+    xjson.close();
+
+    xjson.close();
+
+    //======================================
+
+    if (xconf.m_xstr_json.empty())
+    {
+        std::cout << xjson.text() << std::endl;
+    }
+    else
+    {
+        std::ofstream xofs(xconf.m_xstr_json.c_str(), std::ios_base::out | std::ios_base::trunc);
+        xofs << xjson.text() << std::endl;
+        if (!xofs.good())
+        {
+            std::cerr << "write " << xconf.m_xstr_json << " failed." << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
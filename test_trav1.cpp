@@ -80,10 +80,10 @@ int main(int argc, char * argv[])
  * @brief 测试 INI 的 节点遍历操作。
  * 
  * @note 
- * 节点遍历操作的过程时，若调用 xini_file_t::sect_remove() 或 
- * xini_section_t::key_remove() 操作，会更新内部 节点存储链表，
- * 可能会引发遍历操作的异常，此情况应当慎重对待，
- * 如 remove() 后就结束遍历，这是允许的。
+ * 节点遍历操作的过程时，若要删除 当前迭代器 所指向的节点，
+ * 应调用 xini_file_t::erase() 或 xini_section_t::erase()，
+ * 两者均返回下一个节点的迭代器，可在一次遍历中完成删除操作；
+ * 删除其他节点（sect_remove() 或 key_remove()）不会影响当前迭代器。
  */
 void test_ini_trav(const std::string & xstr_file)
 {
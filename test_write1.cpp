@@ -41,6 +41,12 @@
  */
 void test_ini_write(const std::string & xstr_file);
 
+/**********************************************************/
+/**
+ * @brief 测试 克隆对象（写时复制）的写隔离。
+ */
+void test_ini_clone(void);
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /**********************************************************/
@@ -75,6 +81,7 @@ int main(int argc, char * argv[])
     }
 
     test_ini_write(xstr_file);
+    test_ini_clone();
 
     return 0;
 }
@@ -193,3 +200,46 @@ void test_ini_write(const std::string & xstr_file)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
+
+/**********************************************************/
+/**
+ * @brief 测试 克隆对象（写时复制）的写隔离。
+ */
+void test_ini_clone(void)
+{
+    xini_file_t xini_src;
+    xini_src["section"]["Key"] = 1;
+
+    // 克隆之前取得的引用，指向的是 克隆后共享的分节
+    xini_section_t  & xsect = xini_src["section"];
+    xini_keyvalue_t & xndkv = xini_src["section"]["Key"];
+
+    xini_file_t xini_dst(xini_src);
+
+    // 经由这些引用写入 会同时修改克隆对象，故克隆后只读
+    assert(!xsect.is_writable());
+    assert(!xndkv.is_writable());
+    (void)xsect;
+    (void)xndkv;
+
+    // 经由 xini_file_t 重新索引后写入，各自复制出独占的分节，互不影响
+    xini_src["section"]["Key"] = 2;
+    xini_dst["section"]["Key"] = 3;
+    xini_dst["section"].key_remove("Key");
+    xini_dst["section"]["New"] = 4;
+
+    const xini_file_t & xsrc_cref = xini_src;
+    const xini_file_t & xdst_cref = xini_dst;
+
+    std::cout << "test_ini_clone() output: " << std::endl;
+    std::cout << "----------------------------------------" << std::endl;
+
+    std::cout << "src : Key = " << (int)xsrc_cref["section"]["Key"]
+              << ", New = "     << (int)xsrc_cref["section"]["New"] << std::endl;
+    std::cout << "dst : Key = " << (int)xdst_cref["section"]["Key"]
+              << ", New = "     << (int)xdst_cref["section"]["New"] << std::endl;
+
+    std::cout << "----------------------------------------" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,295 @@
+﻿/**
+ * The MIT License (MIT)
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file xini_environ.h
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * @author  ：Gaaagaa
+ * @date    : 2026-10-19
+ * @version : 1.0.0.0
+ * @brief   : 以环境变量（如 APP__SECTION__KEY）覆盖 INI 键值的配置层。
+ */
+
+#ifndef __XINI_ENVIRON_H__
+#define __XINI_ENVIRON_H__
+
+#include "xini_overlay.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define XINI_ENVIRON _environ
+#else // !_WIN32
+extern char ** environ;
+#define XINI_ENVIRON environ
+#endif // _WIN32
+
+////////////////////////////////////////////////////////////////////////////////
+// xini_environ_t
+
+/**
+ * @class xini_environ_t
+ * @brief 环境变量配置层：扫描一次环境变量，将符合命名规则的变量映射为（分节, 键）。
+ *
+ * <pre>
+ * 命名规则为：前缀 + 分隔符 + 分节名 + 分隔符 + 键名，如 APP__DB__PORT=5432
+ * 映射为 [DB] 分节下的 PORT=5432（分节名、键名 均忽略大小写）；
+ * 只有 前缀 + 分隔符 + 键名 的变量（如 APP__DEBUG=1）映射到无名分节。
+ * 键名中可再出现分隔符（如 APP__DB__POOL__MAX 映射为 [DB] 分节下的 POOL__MAX）。
+ *
+ * 扫描结果存放于一个 xini_file_t 对象中，可作为优先级最高的层加入 xini_overlay_t，
+ * 此时没有被覆盖的键值，查找开销不变（合并索引为哈希表）；
+ * 也可直接通过 find() 单独查询（同样为哈希索引）。
+ *
+ * 使用示例：
+ *  xini_environ_t xenviron("APP");
+ *  xenviron.scan();
+ *  xenviron.apply(xoverlay);
+ * </pre>
+ */
+class xini_environ_t
+{
+    // common data types
+protected:
+#ifdef XINI_CXX11
+    typedef std::unordered_map< std::string, const xini_keyvalue_t * > xmap_index_t;
+#else // !XINI_CXX11
+    typedef std::map< std::string, const xini_keyvalue_t * > xmap_index_t;
+#endif // XINI_CXX11
+
+    // constructor/destructor
+public:
+    /**********************************************************/
+    /**
+     * @brief 构造函数。
+     * 
+     * @param [in ] xstr_prefix : 环境变量名的前缀（忽略大小写）。
+     * @param [in ] xstr_delim  : 前缀、分节名、键名 之间的分隔符。
+     */
+    explicit xini_environ_t(const std::string & xstr_prefix = "APP",
+                            const std::string & xstr_delim  = "__")
+        : m_xstr_prefix(xstr_prefix)
+        , m_xstr_delim(xstr_delim)
+    {
+
+    }
+
+    ~xini_environ_t(void)
+    {
+
+    }
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 扫描环境变量（只需调用一次），建立 （分节, 键） 的索引。
+     * 
+     * @param [in ] xenvp : 环境变量表（以 NULL 结尾），为 NULL 时使用当前进程的环境变量。
+     * 
+     * @return size_t : 映射的键值数量。
+     */
+    size_t scan(char ** xenvp = NULL)
+    {
+        m_xini_file.release();
+        m_xmap_index.clear();
+
+        if (NULL == xenvp)
+        {
+            xenvp = XINI_ENVIRON;
+        }
+
+        const std::string xstr_lead = m_xstr_prefix + m_xstr_delim;
+
+        for (; (NULL != xenvp) && (NULL != *xenvp); ++xenvp)
+        {
+            const char * xszt_envs = *xenvp;
+            const char * xszt_eq   = strchr(xszt_envs, '=');
+            if (NULL == xszt_eq)
+                continue;
+
+            std::string xstr_vname(xszt_envs, xszt_eq);
+            if ((xstr_vname.size() <= xstr_lead.size()) ||
+                !is_iprefix(xstr_vname, xstr_lead))
+            {
+                continue;
+            }
+
+            std::string xstr_sect;
+            std::string xstr_key = xstr_vname.substr(xstr_lead.size());
+
+            std::string::size_type xst_pos = xstr_key.find(m_xstr_delim);
+            if ((std::string::npos != xst_pos) && (xst_pos > 0))
+            {
+                xstr_sect = xstr_key.substr(0, xst_pos);
+                xstr_key  = xstr_key.substr(xst_pos + m_xstr_delim.size());
+            }
+
+            if (!is_kname(xstr_key) ||
+                (std::string::npos != xstr_sect.find_first_of("[]")))
+            {
+                continue;
+            }
+
+            m_xini_file[xstr_sect][xstr_key] = std::string(xszt_eq + 1);
+        }
+
+        // 环境变量层只用于读取，不回写
+        m_xini_file.set_dirty(false);
+
+        //======================================
+        // 建立哈希索引
+
+        const xini_file_t & xfile_cref = m_xini_file;
+        for (xini_file_t::const_iterator
+                itsect  = xfile_cref.begin();
+                itsect != xfile_cref.end();
+                ++itsect)
+        {
+            for (xini_section_t::kv_const_iterator
+                    itkv  = (*itsect)->kv_begin();
+                    itkv != (*itsect)->kv_end();
+                    ++itkv)
+            {
+                m_xmap_index[index_name((*itsect)->name(), (*itkv)->key())] = *itkv;
+            }
+        }
+
+        return m_xmap_index.size();
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 查找环境变量覆盖的键值。
+     * 
+     * @return const xini_keyvalue_t * : 未被覆盖时返回 NULL 。
+     */
+    const xini_keyvalue_t * find(const std::string & xstr_sect,
+                                 const std::string & xstr_key) const
+    {
+        if (m_xmap_index.empty())
+        {
+            return NULL;
+        }
+
+        xmap_index_t::const_iterator itmap = m_xmap_index.find(index_name(xstr_sect, xstr_key));
+        if (itmap == m_xmap_index.end())
+        {
+            return NULL;
+        }
+
+        return itmap->second;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 作为优先级最高的层，加入到 xini_overlay_t 中。
+     * 
+     * @return size_t : 层号。
+     */
+    size_t apply(xini_overlay_t & xoverlay, const std::string & xstr_name = "environ") const
+    {
+        return xoverlay.push_layer(m_xini_file, xstr_name);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 扫描结果（分节、键值 的名称保持环境变量中的原样）。
+     */
+    inline const xini_file_t & file(void) const { return m_xini_file; }
+
+    /**********************************************************/
+    /**
+     * @brief 映射的键值数量。
+     */
+    inline size_t size(void) const { return m_xmap_index.size(); }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 判断字符串是否以指定前缀开头（忽略 ASCII 大小写）。
+     */
+    static bool is_iprefix(const std::string & xstr, const std::string & xstr_prefix)
+    {
+        for (std::string::size_type xst_iter = 0; xst_iter < xstr_prefix.size(); ++xst_iter)
+        {
+            if (fold(xstr[xst_iter]) != fold(xstr_prefix[xst_iter]))
+                return false;
+        }
+
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 判断是否可作为键名（规则同 xini_keyvalue_t 的键名）。
+     */
+    static bool is_kname(const std::string & xstr_key)
+    {
+        return (!xstr_key.empty() &&
+                (std::string::npos == xstr_key.find_first_of(";#=[] \t\r\n")));
+    }
+
+    /**********************************************************/
+    /**
+     * @brief ASCII 字符转小写。
+     */
+    static inline char fold(char xchar)
+    {
+        return ((xchar >= 'A') && (xchar <= 'Z')) ? static_cast< char >(xchar + ('a' - 'A')) : xchar;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 哈希索引中的 索引名（转为小写，与 xstr_icmp() 一致）。
+     */
+    static std::string index_name(const std::string & xstr_sect, const std::string & xstr_key)
+    {
+        std::string xstr_name;
+        xstr_name.reserve(xstr_sect.size() + xstr_key.size() + 1);
+        xstr_name.append(xstr_sect).append(1, '\n').append(xstr_key);
+
+        for (std::string::iterator
+                itstr  = xstr_name.begin();
+                itstr != xstr_name.end();
+                ++itstr)
+        {
+            *itstr = fold(*itstr);
+        }
+
+        return xstr_name;
+    }
+
+    // data members
+protected:
+    std::string  m_xstr_prefix;  ///< 环境变量名的前缀
+    std::string  m_xstr_delim;   ///< 分隔符
+    xini_file_t  m_xini_file;    ///< 扫描结果
+    xmap_index_t m_xmap_index;   ///< 哈希索引
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XINI_ENVIRON_H__
@@ -51,10 +51,45 @@
 
 #include <list>
 #include <map>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <iterator>
 #include <string>
+#include <cstring>
 #include <sstream>
 #include <fstream>
 #include <cassert>
+#include <cstdlib>
+#include <sys/stat.h>
+
+/** 是否支持 C++11 （部分功能在 C++11 下会有更好的实现） */
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && (_MSC_VER >= 1900))
+#define XINI_CXX11 1
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#endif // C++11
+
+/** 是否支持 C++14 （插值展开缓存 使用读写锁，命中缓存时 读线程之间不互斥） */
+#if defined(XINI_CXX11) && ((__cplusplus >= 201402L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201402L)))
+#define XINI_CXX14 1
+#include <shared_mutex>
+#endif // C++14
+
+/** 包含文件（@include）的最大嵌套层数，超过的包含指令被忽略 */
+#ifndef XINI_INCLUDE_DEPTH
+#define XINI_INCLUDE_DEPTH 16
+#endif // XINI_INCLUDE_DEPTH
+
+/** 引用计数类型（用于 xini_file_t 克隆对象之间共享的 分节表 与 分节） */
+#ifdef XINI_CXX11
+typedef std::atomic< long > xini_refcnt_t;
+#else // !XINI_CXX11
+typedef long xini_refcnt_t;
+#endif // XINI_CXX11
 
 ////////////////////////////////////////////////////////////////////////////////
 // xini_node_t : INI 节点的抽象定义
@@ -105,6 +140,7 @@ typedef enum xini_ntype_t
 {
     XINI_NTYPE_UNDEFINE = 0xFFFFFFFF, ///< 未定义
     XINI_NTYPE_FILEROOT = 0x00000000, ///< 文件根
+    XINI_NTYPE_SECTTBL  = 0x00000010, ///< 分节表（内部节点，分节 的持有者）
     XINI_NTYPE_NILLINE  = 0x00000100, ///< 空行
     XINI_NTYPE_COMMENT  = 0x00000200, ///< 注释
     XINI_NTYPE_SECTION  = 0x00000300, ///< 分节
@@ -121,6 +157,346 @@ class xini_file_t;
 /** 字符串修剪操作的默认字符集（空白字符集，以 isspace() 判断的字符为标准） */
 static const char XCHARS_TRIM[] = " \t\n\r\f\v";
 
+/**
+ * @struct xini_memory_t
+ * @brief  内存占用统计（字节数）。
+ * @note
+ *  依据各个对象的 sizeof() 以及 标准容器 的常见实现（链表节点 2 个指针、
+ *  红黑树节点 4 个指针 大小的链接信息）估算，并非分配器的精确统计。
+ */
+struct xini_memory_t
+{
+    size_t m_xst_strings;   ///< 字符串（分节名、键名、键值、注释 等）在堆上的内存
+    size_t m_xst_nodes;     ///< 节点对象（分节、键值、注释、空行）本身
+    size_t m_xst_indexes;   ///< 索引：节点表、映射表、键值序列 的元素与链接
+    size_t m_xst_overhead;  ///< 内存分配的额外开销（每次分配按 2 个指针大小估算）
+    size_t m_xst_allocs;    ///< 内存分配的次数
+
+    xini_memory_t(void)
+        : m_xst_strings(0)
+        , m_xst_nodes(0)
+        , m_xst_indexes(0)
+        , m_xst_overhead(0)
+        , m_xst_allocs(0)
+    {
+
+    }
+
+    /**
+     * @brief 总字节数。
+     */
+    inline size_t total(void) const
+    {
+        return (m_xst_strings + m_xst_nodes + m_xst_indexes + m_xst_overhead);
+    }
+
+    xini_memory_t & operator += (const xini_memory_t & xmem)
+    {
+        m_xst_strings  += xmem.m_xst_strings ;
+        m_xst_nodes    += xmem.m_xst_nodes   ;
+        m_xst_indexes  += xmem.m_xst_indexes ;
+        m_xst_overhead += xmem.m_xst_overhead;
+        m_xst_allocs   += xmem.m_xst_allocs  ;
+        return *this;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// xini_strpool_t : 键名的字符串池
+
+class xini_strpool_t;
+
+/**
+ * @struct xini_atom_t
+ * @brief  字符串池中驻留的字符串（原子）。
+ * @note
+ *  同一字符串池中，文本相同的原子只有一个；每个原子都关联其 小写形式 的原子
+ *  （文本本身即为小写时，关联自身），故同一池中的两个原子 忽略大小写 相等，
+ *  当且仅当 二者的 m_xfold_ptr 相同，只需比较指针。
+ */
+struct xini_atom_t
+{
+    const char        * m_xszt_text;   ///< 文本（驻留原子指向 m_xstr_text，查找用的临时原子指向外部字符串）
+    size_t              m_xst_size;    ///< 文本长度
+    size_t              m_xst_hash;    ///< 文本的哈希值（FNV-1a）
+    const xini_atom_t * m_xfold_ptr;   ///< 小写形式 的原子（临时原子为 NULL）
+    xini_strpool_t    * m_xpool_ptr;   ///< 所属的字符串池（临时原子为 NULL）
+    mutable xini_refcnt_t m_xref_count; ///< 引用计数
+    std::string         m_xstr_text;   ///< 文本
+
+    /**
+     * @brief 构造查找用的临时原子（不复制文本）。
+     */
+    xini_atom_t(const char * xszt_text, size_t xst_size, size_t xst_hash = 0)
+        : m_xszt_text(xszt_text)
+        , m_xst_size(xst_size)
+        , m_xst_hash(xst_hash)
+        , m_xfold_ptr(NULL)
+        , m_xpool_ptr(NULL)
+        , m_xref_count(0)
+    {
+
+    }
+
+    /**
+     * @brief 计算字符串的哈希值（FNV-1a）。
+     */
+    static size_t hash(const char * xszt_text, size_t xst_size)
+    {
+        size_t xst_hash = static_cast< size_t >(2166136261U);
+        for (size_t xst_iter = 0; xst_iter < xst_size; ++xst_iter)
+        {
+            xst_hash ^= static_cast< unsigned char >(xszt_text[xst_iter]);
+            xst_hash *= static_cast< size_t >(16777619U);
+        }
+        return xst_hash;
+    }
+
+    // 禁用 拷贝构造 和 =负值 操作
+private:
+    xini_atom_t(const xini_atom_t & xobject);
+    xini_atom_t & operator = (const xini_atom_t & xobject);
+};
+
+/**
+ * @class xini_strpool_t
+ * @brief 键名的字符串池（驻留字符串），由 xini_file_t 及其克隆对象共享。
+ * @note
+ *  同名的键（即便分布在不同分节）只保存一份键名文本，键值节点 与 映射表
+ *  只持有原子指针；原子的引用计数归零时，从池中移除。
+ *  字符串池 自身的引用计数 包括 持有它的文件对象 与 池中的各个原子，
+ *  故原子可比文件对象存活得更久（如 被其他文件克隆的分节）。
+ *  驻留、释放 操作 在 C++11 下加锁保护；只读的 键值索引 不访问字符串池。
+ */
+class xini_strpool_t
+{
+    // common data types
+protected:
+    /**
+     * @struct xatom_less_t
+     * @brief  池中原子的排序：先比较哈希值，再比较文本。
+     */
+    struct xatom_less_t
+    {
+        bool operator () (const xini_atom_t * xatom_left,
+                          const xini_atom_t * xatom_right) const
+        {
+            if (xatom_left->m_xst_hash != xatom_right->m_xst_hash)
+                return (xatom_left->m_xst_hash < xatom_right->m_xst_hash);
+            if (xatom_left->m_xst_size != xatom_right->m_xst_size)
+                return (xatom_left->m_xst_size < xatom_right->m_xst_size);
+            return (memcmp(xatom_left->m_xszt_text,
+                           xatom_right->m_xszt_text,
+                           xatom_left->m_xst_size) < 0);
+        }
+    };
+
+    typedef std::set< xini_atom_t *, xatom_less_t > xset_atom_t;
+
+    // constructor/destructor
+public:
+    xini_strpool_t(void)
+        : m_xref_count(1)
+    {
+
+    }
+
+protected:
+    ~xini_strpool_t(void)
+    {
+        assert(m_xset_atom.empty());
+    }
+
+    // 禁用 拷贝构造 和 =负值 操作
+private:
+    xini_strpool_t(const xini_strpool_t & xobject);
+    xini_strpool_t & operator = (const xini_strpool_t & xobject);
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 增加字符串池的引用计数。
+     */
+    inline void retain(void)
+    {
+        ++m_xref_count;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 减少字符串池的引用计数（归零时销毁）。
+     */
+    inline void release(void)
+    {
+        if (0 == --m_xref_count)
+        {
+            delete this;
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 驻留字符串：返回文本为 xstr_text 的原子（引用计数加 1），不存在时新建。
+     */
+    const xini_atom_t * intern(const std::string & xstr_text)
+    {
+#ifdef XINI_CXX11
+        std::lock_guard< std::mutex > xlock(m_xmutex_pool);
+#endif // XINI_CXX11
+        return intern_nlock(xstr_text);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 增加原子的引用计数（调用方须已持有该原子）。
+     */
+    static inline const xini_atom_t * retain(const xini_atom_t * xatom_ptr)
+    {
+        ++xatom_ptr->m_xref_count;
+        return xatom_ptr;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 减少原子的引用计数（归零时从所属的字符串池中移除）。
+     */
+    static void release(const xini_atom_t * xatom_ptr)
+    {
+        xini_strpool_t * xpool_ptr = xatom_ptr->m_xpool_ptr;
+        size_t xst_count = 0;
+
+        {
+#ifdef XINI_CXX11
+            std::lock_guard< std::mutex > xlock(xpool_ptr->m_xmutex_pool);
+#endif // XINI_CXX11
+            xst_count = xpool_ptr->release_nlock(const_cast< xini_atom_t * >(xatom_ptr));
+        }
+
+        // 每个原子持有字符串池的一个引用，须在解锁后释放
+        while (xst_count-- > 0)
+        {
+            xpool_ptr->release();
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 池中的原子数量。
+     */
+    size_t size(void) const
+    {
+#ifdef XINI_CXX11
+        std::lock_guard< std::mutex > xlock(m_xmutex_pool);
+#endif // XINI_CXX11
+        return m_xset_atom.size();
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 遍历池中的各个原子。
+     * 
+     * @param [in ] xfunc_visit : 访问函数（对象），原型为 void (const xini_atom_t &)。
+     */
+    template< typename __func_type >
+    void visit(__func_type xfunc_visit) const
+    {
+#ifdef XINI_CXX11
+        std::lock_guard< std::mutex > xlock(m_xmutex_pool);
+#endif // XINI_CXX11
+        for (xset_atom_t::const_iterator
+                itset  = m_xset_atom.begin();
+                itset != m_xset_atom.end();
+                ++itset)
+        {
+            xfunc_visit(**itset);
+        }
+    }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 驻留字符串（调用方已加锁）。
+     */
+    xini_atom_t * intern_nlock(const std::string & xstr_text)
+    {
+        xini_atom_t xatom_find(xstr_text.c_str(), xstr_text.size(),
+                               xini_atom_t::hash(xstr_text.c_str(), xstr_text.size()));
+
+        xset_atom_t::iterator itset = m_xset_atom.find(&xatom_find);
+        if (itset != m_xset_atom.end())
+        {
+            ++(*itset)->m_xref_count;
+            return *itset;
+        }
+
+        //======================================
+
+        xini_atom_t * xatom_ptr = new xini_atom_t(NULL, xstr_text.size(), xatom_find.m_xst_hash);
+        xatom_ptr->m_xstr_text  = xstr_text;
+        xatom_ptr->m_xszt_text  = xatom_ptr->m_xstr_text.c_str();
+        xatom_ptr->m_xpool_ptr  = this;
+        xatom_ptr->m_xref_count = 1;
+        xatom_ptr->m_xfold_ptr  = xatom_ptr;
+
+        for (size_t xst_iter = 0; xst_iter < xstr_text.size(); ++xst_iter)
+        {
+            if ((xstr_text[xst_iter] >= 'A') && (xstr_text[xst_iter] <= 'Z'))
+            {
+                std::string xstr_fold = xstr_text;
+                for (; xst_iter < xstr_fold.size(); ++xst_iter)
+                {
+                    if ((xstr_fold[xst_iter] >= 'A') && (xstr_fold[xst_iter] <= 'Z'))
+                        xstr_fold[xst_iter] -= ('A' - 'a');
+                }
+
+                xatom_ptr->m_xfold_ptr = intern_nlock(xstr_fold);
+                break;
+            }
+        }
+
+        m_xset_atom.insert(xatom_ptr);
+        ++m_xref_count;
+
+        return xatom_ptr;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 减少原子的引用计数（调用方已加锁）。
+     * 
+     * @return size_t : 被移除的原子数量（包括随之释放的 小写形式 原子）。
+     */
+    size_t release_nlock(xini_atom_t * xatom_ptr)
+    {
+        if (0 != --xatom_ptr->m_xref_count)
+        {
+            return 0;
+        }
+
+        m_xset_atom.erase(xatom_ptr);
+
+        size_t xst_count = 1;
+        if (xatom_ptr->m_xfold_ptr != xatom_ptr)
+        {
+            xst_count += release_nlock(const_cast< xini_atom_t * >(xatom_ptr->m_xfold_ptr));
+        }
+
+        delete xatom_ptr;
+
+        return xst_count;
+    }
+
+    // data members
+protected:
+    xini_refcnt_t  m_xref_count;   ///< 引用计数（持有的文件对象 与 池中的原子）
+    xset_atom_t    m_xset_atom;    ///< 池中的原子
+#ifdef XINI_CXX11
+    mutable std::mutex m_xmutex_pool; ///< 保护 m_xset_atom
+#endif // XINI_CXX11
+};
+
 /**
  * @class xini_node_t
  * @brief INI 节点描述基类。
@@ -242,6 +618,54 @@ protected:
         return (xit_lvalue - xit_rvalue);
     }
 
+    /**********************************************************/
+    /**
+     * @brief 内存统计：记录一次堆内存分配。
+     */
+    static inline void mem_alloc(xini_memory_t & xmem)
+    {
+        xmem.m_xst_allocs   += 1;
+        xmem.m_xst_overhead += 2 * sizeof(void *);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 内存统计：字符串在堆上的内存（短字符串优化 存放在对象内部的，不计入）。
+     */
+    static inline void mem_string(xini_memory_t & xmem, const std::string & xstr)
+    {
+        static const std::string::size_type xst_local = std::string().capacity();
+        if (xstr.capacity() > xst_local)
+        {
+            xmem.m_xst_strings += xstr.capacity() + 1;
+            mem_alloc(xmem);
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 内存统计：链表 的节点（元素 与 前后链接）。
+     */
+    template< typename __value_type >
+    static inline void mem_lnode(xini_memory_t & xmem, size_t xst_count)
+    {
+        xmem.m_xst_indexes  += xst_count * (sizeof(__value_type) + 2 * sizeof(void *));
+        xmem.m_xst_allocs   += xst_count;
+        xmem.m_xst_overhead += xst_count * 2 * sizeof(void *);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 内存统计：映射表（红黑树）的节点（元素 与 颜色、父子链接）。
+     */
+    template< typename __value_type >
+    static inline void mem_tnode(xini_memory_t & xmem, size_t xst_count)
+    {
+        xmem.m_xst_indexes  += xst_count * (sizeof(__value_type) + 4 * sizeof(void *));
+        xmem.m_xst_allocs   += xst_count;
+        xmem.m_xst_overhead += xst_count * 2 * sizeof(void *);
+    }
+
     /**
      * @struct xstr_icmp_t
      * @brief  as functor.
@@ -260,88 +684,202 @@ protected:
         }
     };
 
-    // constructor/destructor
-protected:
-    xini_node_t(int xini_ntype, xini_node_t * xowner_ptr)
-        : m_xini_ntype(xini_ntype)
-        , m_xowner_ptr(xowner_ptr)
+    /**********************************************************/
+    /**
+     * @brief 判断字符串是否以指定前缀开头（忽略大小写，与 xstr_icmp() 一致）。
+     */
+    static bool xstr_iprefix(const std::string & xstr, const std::string & xstr_prefix)
     {
+        if (xstr.size() < xstr_prefix.size())
+            return false;
 
-    }
+        for (std::string::size_type xst_iter = 0; xst_iter < xstr_prefix.size(); ++xst_iter)
+        {
+            int xit_lvalue = xstr[xst_iter];
+            int xit_rvalue = xstr_prefix[xst_iter];
 
-    virtual ~xini_node_t(void)
-    {
+            if ((xit_lvalue >= 'A') && (xit_lvalue <= 'Z'))
+                xit_lvalue -= ('A' - 'a');
+            if ((xit_rvalue >= 'A') && (xit_rvalue <= 'Z'))
+                xit_rvalue -= ('A' - 'a');
+
+            if (xit_lvalue != xit_rvalue)
+                return false;
+        }
 
+        return true;
     }
 
-    // extensible interfaces
-public:
     /**********************************************************/
     /**
-     * @brief 将 节点信息 导向 输出流，派生的子类中必须实现具体操作。
+     * @brief 映射表索引键 的文本（分节名 为字符串，键名 为字符串池中的原子）。
      */
-    virtual const xini_node_t & operator >> (std::ostream & ostr) const = 0;
+    static inline const std::string & key_text(const std::string & xstr_key)
+    {
+        return xstr_key;
+    }
 
-    /**********************************************************/
-    /**
-     * @brief 脏标识。
-     */
-    virtual bool is_dirty(void) const
+    static inline const std::string & key_text(const xini_atom_t * xatom_key)
     {
-        if (NULL != m_xowner_ptr)
-        {
-            return m_xowner_ptr->is_dirty();
-        }
-        return false;
+        return xatom_key->m_xstr_text;
     }
 
     /**********************************************************/
     /**
-     * @brief 设置脏标识。
+     * @brief 在以 xstr_icmp_t 排序的映射表中，定位键名带有指定前缀的连续区间。
+     * @note
+     *  前缀相同的键名，在映射表中必然连续存放；但因 xstr_icmp() 按 char
+     *  （可能有符号）比较，前缀之后为非 ASCII 字符的键名会排在 前缀本身 之前，
+     *  故需从 lower_bound() 的位置分别向前、向后扩展。
+     *  时间复杂度为 O(log n + 结果数量)。
+     * 
+     * @param [in ] xmap_ndsub   : 映射表。
+     * @param [in ] xkey_prefix  : 以前缀作为 映射表索引键 的形式（用于 lower_bound()）。
+     * @param [in ] xstr_prefix  : 前缀。
+     * @param [out] xiter_begin  : 区间起始位置。
+     * @param [out] xiter_end    : 区间结束位置。
      */
-    virtual void set_dirty(bool x_dirty)
+    template< typename __map_type >
+    static void prefix_range(const __map_type & xmap_ndsub,
+                             const typename __map_type::key_type & xkey_prefix,
+                             const std::string & xstr_prefix,
+                             typename __map_type::const_iterator & xiter_begin,
+                             typename __map_type::const_iterator & xiter_end)
     {
-        if (NULL != m_xowner_ptr)
+        typename __map_type::const_iterator itmap = xmap_ndsub.lower_bound(xkey_prefix);
+
+        xiter_begin = itmap;
+        while (xiter_begin != xmap_ndsub.begin())
         {
-            m_xowner_ptr->set_dirty(x_dirty);
+            typename __map_type::const_iterator itprev = xiter_begin;
+            if (!xstr_iprefix(key_text((--itprev)->first), xstr_prefix))
+                break;
+            xiter_begin = itprev;
+        }
+
+        xiter_end = itmap;
+        while ((xiter_end != xmap_ndsub.end()) &&
+               xstr_iprefix(key_text(xiter_end->first), xstr_prefix))
+        {
+            ++xiter_end;
         }
     }
 
+    // constructor/destructor
 protected:
-    /**********************************************************/
+    xini_node_t(int xini_ntype, xini_node_t * xowner_ptr)
+        : m_xowner_ptr(xowner_ptr)
+        , m_xini_ntype(xini_ntype)
+    {
+
+    }
+
     /**
-     * @brief 重命名附属的子节点（分节节点、键值节点）的索引名。
+     * @note
+     *  节点类 不含虚函数（节点对象中没有虚表指针），析构函数 也不是虚函数，
+     *  须经由 destroy() 按 节点类型 释放节点。
      */
-    virtual bool rename_nsub(
-                    xini_node_t * xnsub_ptr,
-                    const std::string & xstr_name)
+    ~xini_node_t(void)
     {
-        return false;
+
     }
 
-    // public interfaces
+    // node interfaces : 按 ntype() 分派到具体的节点类（xini_file_t 定义之后实现）
 public:
     /**********************************************************/
     /**
-     * @brief 节点类型。
+     * @brief 将 节点信息 导向 输出流。
      */
-    inline int ntype(void) const { return m_xini_ntype; }
+    inline const xini_node_t & operator >> (std::ostream & ostr) const;
 
     /**********************************************************/
     /**
-     * @brief 获取节点的持有者。
+     * @brief 脏标识（即 所属文件 的脏标识）。
      */
-    inline xini_node_t * get_owner(void) const { return m_xowner_ptr; }
+    inline bool is_dirty(void) const;
 
-    // data members
-protected:
-    int           m_xini_ntype;   ///< 节点类型
-    xini_node_t * m_xowner_ptr;   ///< 节点持有者
-};
+    /**********************************************************/
+    /**
+     * @brief 设置脏标识（即 所属文件 的脏标识）。
+     */
+    inline void set_dirty(bool x_dirty);
 
-/**********************************************************/
-/**
- * @brief 定义 xini_node_t 的流输出操作符函数。
+    /**********************************************************/
+    /**
+     * @brief 通知内容变化（用于 键值插值展开 的缓存失效处理）。
+     * 
+     * @param [in ] xnode_ptr : 键值被修改的 键值节点；
+     *                          为 NULL 时，表示 分节/键值 的增删 或 重命名。
+     */
+    inline void notify_change(const xini_node_t * xnode_ptr);
+
+    /**********************************************************/
+    /**
+     * @brief 是否可经由该节点（或其引用）写入。
+     * @note
+     *  所在的 分节 或 分节表 仍与 xini_file_t 克隆对象共享，或者已脱离文件
+     *  （写入文件时 已复制出新的分节）时，返回 false；此时写入会波及克隆对象，
+     *  故 分节/键值 的修改接口 均拒绝写入（调试版本 触发断言）。
+     */
+    inline bool is_writable(void) const;
+
+    /**********************************************************/
+    /**
+     * @brief 节点所属文件的 键名字符串池（由 xini_file_t 持有）。
+     */
+    inline xini_strpool_t * get_pool(void);
+
+protected:
+    /**********************************************************/
+    /**
+     * @brief 重命名附属的子节点（分节节点、键值节点）的索引名。
+     */
+    inline bool rename_nsub(xini_node_t * xnsub_ptr, const std::string & xstr_name);
+
+    /**********************************************************/
+    /**
+     * @brief 按 节点类型 释放节点。
+     */
+    static inline void destroy(xini_node_t * xnode_ptr);
+
+    /**********************************************************/
+    /**
+     * @brief 节点所属的文件对象（沿持有者逐级上溯：键值节点 至多三级）。
+     */
+    inline xini_file_t * owner_file(void) const;
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 节点类型。
+     */
+    inline int ntype(void) const { return m_xini_ntype; }
+
+    /**********************************************************/
+    /**
+     * @brief 获取节点的持有者。
+     * @note
+     *  分节 由所属文件的 分节表 持有（参看 xini_file_t::xsect_table_t），
+     *  此处越过分节表，返回所属文件；分节已脱离文件时（如 文件已析构，
+     *  分节仍被其克隆对象共享），返回 NULL 。
+     */
+    inline xini_node_t * get_owner(void) const
+    {
+        if ((NULL != m_xowner_ptr) && (XINI_NTYPE_SECTTBL == m_xowner_ptr->m_xini_ntype))
+            return m_xowner_ptr->m_xowner_ptr;
+        return m_xowner_ptr;
+    }
+
+    // data members
+protected:
+    xini_node_t * m_xowner_ptr;   ///< 节点持有者
+    int           m_xini_ntype;   ///< 节点类型（其后的填充字节 可被派生类的成员使用）
+};
+
+/**********************************************************/
+/**
+ * @brief 定义 xini_node_t 的流输出操作符函数。
  */
 inline std::ostream & operator << (
     std::ostream & ostr, const xini_node_t & xini_node)
@@ -359,7 +897,9 @@ inline std::ostream & operator << (
  */
 class xini_nilline_t : public xini_node_t
 {
+    friend class xini_node_t;
     friend class xini_file_t;
+    friend class xini_section_t;
 
     // common invoking
 protected:
@@ -401,7 +941,7 @@ protected:
 
     }
 
-    virtual ~xini_nilline_t(void)
+    ~xini_nilline_t(void)
     {
 
     }
@@ -412,7 +952,7 @@ public:
     /**
      * @brief 将 节点信息 导向 输出流。
      */
-    virtual const xini_node_t & operator >> (std::ostream & ostr) const
+    const xini_node_t & operator >> (std::ostream & ostr) const
     {
         ostr << std::endl;
         return *this;
@@ -428,7 +968,9 @@ public:
  */
 class xini_comment_t : public xini_node_t
 {
+    friend class xini_node_t;
     friend class xini_file_t;
+    friend class xini_section_t;
 
     // common invoking
 protected:
@@ -473,7 +1015,7 @@ protected:
 
     }
 
-    virtual ~xini_comment_t(void)
+    ~xini_comment_t(void)
     {
 
     }
@@ -484,7 +1026,7 @@ public:
     /**
      * @brief 将 节点信息 导向 输出流。
      */
-    virtual const xini_node_t & operator >> (std::ostream & ostr) const
+    const xini_node_t & operator >> (std::ostream & ostr) const
     {
         ostr << m_xstr_text << std::endl;
         return *this;
@@ -511,6 +1053,7 @@ protected:
  */
 class xini_keyvalue_t : public xini_node_t
 {
+    friend class xini_node_t;
     friend class xini_file_t;
     friend class xini_section_t;
 
@@ -546,6 +1089,116 @@ protected:
         return true;
     }
 
+    /**********************************************************/
+    /**
+     * @brief 查找 行内注释 的起始位置：st_pos 之后，空白字符 后面的 ';' 或 '#' 。
+     */
+    static size_t find_cmark(const std::string & xstr_text, size_t st_pos)
+    {
+        for (size_t st_iter = st_pos; st_iter < xstr_text.size(); ++st_iter)
+        {
+            const char xchar = xstr_text[st_iter];
+            if (((';' == xchar) || ('#' == xchar)) && (st_iter > 0) &&
+                ((' ' == xstr_text[st_iter - 1]) || ('\t' == xstr_text[st_iter - 1])))
+            {
+                return st_iter;
+            }
+        }
+
+        return std::string::npos;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 查找 引号字符串 的结束引号（引号内 "\\\"" 与 "\\\\" 为转义字符）。
+     * 
+     * @param [in ] xstr_text : 字符串。
+     * @param [in ] st_open   : 开始引号 的位置。
+     * 
+     * @return size_t : 结束引号 的位置；未找到时，返回 std::string::npos 。
+     */
+    static size_t quote_end(const std::string & xstr_text, size_t st_open)
+    {
+        for (size_t st_iter = st_open + 1; st_iter < xstr_text.size(); ++st_iter)
+        {
+            if ('\\' == xstr_text[st_iter])
+                ++st_iter;
+            else if ('"' == xstr_text[st_iter])
+                return st_iter;
+        }
+
+        return std::string::npos;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 输出时 键值（首行）的形式：含有 行内注释标记（空白字符 后面的 ';' 或 '#'）时，
+     *        以引号包围，并转义其中的 '"' 与 '\\'；否则原样输出。
+     * @note
+     *  只有 引号内含有注释标记 的键值，读取时才会去除引号（参看 unquote_value()），
+     *  故原本就带引号的普通键值（如 "abc"）仍保持原样。
+     */
+    static std::string quote_value(const std::string & xstr_value)
+    {
+        if (std::string::npos == find_cmark(xstr_value, 0))
+        {
+            return xstr_value;
+        }
+
+        std::string xstr_quote;
+        xstr_quote.reserve(xstr_value.size() + 8);
+        xstr_quote.push_back('"');
+        for (size_t st_iter = 0; st_iter < xstr_value.size(); ++st_iter)
+        {
+            if (('"' == xstr_value[st_iter]) || ('\\' == xstr_value[st_iter]))
+                xstr_quote.push_back('\\');
+            xstr_quote.push_back(xstr_value[st_iter]);
+        }
+        xstr_quote.push_back('"');
+
+        return xstr_quote;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 还原 quote_value() 输出的键值（结束引号之后 可带有 反斜杠续行 的 '\\'）。
+     */
+    static void unquote_value(std::string & xstr_value)
+    {
+        if (xstr_value.empty() || ('"' != xstr_value[0]))
+        {
+            return;
+        }
+
+        size_t st_close = quote_end(xstr_value, 0);
+        if ((std::string::npos == st_close) ||
+            ((st_close + 1 != xstr_value.size()) &&
+             ((st_close + 2 != xstr_value.size()) || ('\\' != xstr_value[st_close + 1]))))
+        {
+            return;
+        }
+
+        std::string xstr_text;
+        xstr_text.reserve(st_close);
+        for (size_t st_iter = 1; st_iter < st_close; ++st_iter)
+        {
+            if (('\\' == xstr_value[st_iter]) &&
+                (('"' == xstr_value[st_iter + 1]) || ('\\' == xstr_value[st_iter + 1])))
+            {
+                ++st_iter;
+            }
+            xstr_text.push_back(xstr_value[st_iter]);
+        }
+
+        if (std::string::npos == find_cmark(xstr_text, 0))
+        {
+            return;
+        }
+
+        xstr_text.append(xstr_value, st_close + 1, std::string::npos);
+        xstr_value.swap(xstr_text);
+    }
+
     /**********************************************************/
     /**
      * @brief 尝试使用字符串直接创建并初始化 xini_keyvalue_t 对象。
@@ -571,13 +1224,29 @@ protected:
             return NULL;
         }
 
-        // 等号位置
         size_t st_eq = xstr_line.find('=');
         if ((0 == st_eq) || (std::string::npos == st_eq))
         {
             return NULL;
         }
 
+        // 定位 行内注释：键值之后 空白字符 后面的 ';' 或 '#'（键值的首字符 不作为注释）；
+        // 键值以 '"' 开头时，跳过引号内的内容（参看 quote_value()）
+        size_t st_cm = std::string::npos;
+        size_t st_vbeg = xstr_line.find_first_not_of(XCHARS_TRIM, st_eq + 1);
+        if (std::string::npos != st_vbeg)
+        {
+            size_t st_scan = st_vbeg + 1;
+            if ('"' == xstr_line[st_vbeg])
+            {
+                size_t st_close = quote_end(xstr_line, st_vbeg);
+                if (std::string::npos != st_close)
+                    st_scan = st_close + 1;
+            }
+
+            st_cm = find_cmark(xstr_line, st_scan);
+        }
+
         // 键名
         std::string xstr_kname = trim_xstr(xstr_line.substr(0, st_eq));
         if (!check_kname(xstr_kname))
@@ -589,25 +1258,166 @@ protected:
 
         xini_keyvalue_t * xnode_ptr = new xini_keyvalue_t(xowner_ptr);
 
-        xnode_ptr->m_xstr_kname = xstr_kname;
-        xnode_ptr->m_xstr_value = trim_xstr(xstr_line.substr(st_eq + 1));
+        xnode_ptr->set_kname(xstr_kname);
+
+        if (std::string::npos == st_cm)
+        {
+            xnode_ptr->m_xstr_value = trim_xstr(xstr_line.substr(st_eq + 1));
+        }
+        else
+        {
+            // 键值 与 行内注释 之间的空白字符，随注释一起保存
+            size_t st_vend = xstr_line.find_last_not_of(XCHARS_TRIM, st_cm - 1);
+            assert(st_vend > st_eq);
+
+            xnode_ptr->m_xstr_value = trim_xstr(xstr_line.substr(st_eq + 1, st_vend - st_eq));
+            xnode_ptr->m_xstr_ncomm = xstr_line.substr(st_vend + 1);
+        }
+
+        unquote_value(xnode_ptr->m_xstr_value);
 
         //======================================
 
         return xnode_ptr;
     }
 
+    /**********************************************************/
+    /**
+     * @brief 从输入流中读取 键值节点 的续行，构建多行键值。
+     * 
+     * @note
+     * <pre>
+     *  续行 须比 键值所在行 缩进更深，有两种形式：
+     *  1. 反斜杠续行：上一行以 '\\' 结尾（'\\' 不计入键值），直到某行不以 '\\' 结尾；
+     *  2. 缩进续行  ：键值所在行 不以 '\\' 结尾，之后连续的、缩进更深的非空行。
+     *  各行之间以 '\n' 连接，续行 去除与首个续行相同的缩进（保留更深的相对缩进）；
+     *  键值的续行形式记录在节点中，输出时以相同形式写回。
+     *  所有续行先读入，再一次性分配键值所需的内存。
+     * </pre>
+     * 
+     * @param [in    ] istr       : 输入流。
+     * @param [in,out] xndkv_ptr  : 键值节点（由 try_create() 创建）。
+     * @param [in    ] st_indent  : 键值所在行的缩进宽度。
+     * @param [out   ] xstr_next  : 预读到的、不属于续行的下一行（原始文本）。
+     * 
+     * @return bool : 是否预读了下一行（即 xstr_next 有效）。
+     */
+    static bool read_mline(std::istream & istr,
+                           xini_keyvalue_t * xndkv_ptr,
+                           std::string::size_type st_indent,
+                           std::string & xstr_next)
+    {
+        std::string & xstr_value = xndkv_ptr->m_xstr_value;
+        bool xbt_bslash = (!xstr_value.empty() && ('\\' == xstr_value[xstr_value.size() - 1]));
+
+        std::vector< std::string > xvec_line;
+        std::string xstr_indent;
+        bool xbt_next = false;
+
+        while (!istr.eof())
+        {
+            std::getline(istr, xstr_next);
+
+            std::string::size_type st_npos = xstr_next.find_first_not_of(XCHARS_TRIM);
+            if ((std::string::npos == st_npos) || (st_npos <= st_indent))
+            {
+                xbt_next = true;
+                break;
+            }
+
+            if (xvec_line.empty())
+            {
+                xstr_indent = xstr_next.substr(0, st_npos);
+            }
+            else if (0 == xstr_next.compare(0, xstr_indent.size(), xstr_indent))
+            {
+                st_npos = xstr_indent.size();
+            }
+
+            std::string::size_type st_epos = xstr_next.find_last_not_of(XCHARS_TRIM);
+            xvec_line.push_back(xstr_next.substr(st_npos, st_epos + 1 - st_npos));
+
+            if (xbt_bslash)
+            {
+                std::string & xstr_last = xvec_line.back();
+                if (xstr_last.empty() || ('\\' != xstr_last[xstr_last.size() - 1]))
+                    break;
+            }
+        }
+
+        if (xvec_line.empty())
+        {
+            return xbt_next;
+        }
+
+        //======================================
+        // 一次性分配内存，拼接多行键值
+
+        std::string::size_type st_size = xstr_value.size();
+        for (std::vector< std::string >::const_iterator
+                itvec  = xvec_line.begin();
+                itvec != xvec_line.end();
+                ++itvec)
+        {
+            st_size += itvec->size() + 1;
+        }
+
+        std::string xstr_mline;
+        xstr_mline.reserve(st_size);
+        xstr_mline.append(xstr_value, 0, xstr_value.size() - (xbt_bslash ? 1 : 0));
+
+        for (std::vector< std::string >::size_type
+                st_iter  = 0;
+                st_iter < xvec_line.size();
+                ++st_iter)
+        {
+            const std::string & xstr_line = xvec_line[st_iter];
+            bool xbt_cut = (xbt_bslash && ((st_iter + 1) < xvec_line.size()));
+
+            xstr_mline.push_back('\n');
+            xstr_mline.append(xstr_line, 0, xstr_line.size() - (xbt_cut ? 1 : 0));
+        }
+
+        xstr_value.swap(xstr_mline);
+
+        xndkv_ptr->m_xstr_mline = std::string(xbt_bslash ? "\\\n" : "\n") + xstr_indent;
+
+        return xbt_next;
+    }
+
     // construcor/destructor
 protected:
     xini_keyvalue_t(xini_node_t * xowner_ptr)
         : xini_node_t(XINI_NTYPE_KEYVALUE, xowner_ptr)
+        , m_xbt_extern(false)
+        , m_xatom_ptr(NULL)
     {
 
     }
 
-    virtual ~xini_keyvalue_t(void)
+#ifdef XINI_CXX11
+    /**********************************************************/
+    /**
+     * @brief 移动构造（转移 键名/键值 字符串，拥有者由调用方重新设置）。
+     */
+    xini_keyvalue_t(xini_keyvalue_t && xobject) noexcept
+        : xini_node_t(XINI_NTYPE_KEYVALUE, xobject.m_xowner_ptr)
+        , m_xbt_extern(xobject.m_xbt_extern)
+        , m_xatom_ptr(xobject.m_xatom_ptr)
+        , m_xstr_value(std::move(xobject.m_xstr_value))
+        , m_xstr_mline(std::move(xobject.m_xstr_mline))
+        , m_xstr_ncomm(std::move(xobject.m_xstr_ncomm))
     {
+        xobject.m_xatom_ptr = NULL;
+    }
+#endif // XINI_CXX11
 
+    ~xini_keyvalue_t(void)
+    {
+        if (NULL != m_xatom_ptr)
+        {
+            xini_strpool_t::release(m_xatom_ptr);
+        }
     }
 
     // overrides
@@ -616,12 +1426,64 @@ public:
     /**
      * @brief 将 节点信息 导向 输出流。
      */
-    virtual const xini_node_t & operator >> (std::ostream & ostr) const
+    const xini_node_t & operator >> (std::ostream & ostr) const
     {
-        ostr << m_xstr_kname
-             << '='
-             << m_xstr_value
-             << std::endl;
+        ostr << key() << '=';
+
+        std::string::size_type st_lpos = m_xstr_value.find('\n');
+        if (std::string::npos == st_lpos)
+        {
+            ostr << quote_value(m_xstr_value) << m_xstr_ncomm << std::endl;
+            return *this;
+        }
+
+        //======================================
+        // 多行键值：各行之间以续行形式输出
+
+        std::string xstr_mline = m_xstr_mline.empty() ? std::string("\n    ") : m_xstr_mline;
+
+        // 缩进续行 无法表示空行，且首行以 '\\' 结尾时会被当作 反斜杠续行，
+        // 这两种情况改用 反斜杠续行 形式输出
+        if (('\\' != xstr_mline[0]) &&
+            ((std::string::npos != m_xstr_value.find("\n\n")) ||
+             ('\\' == m_xstr_value[st_lpos - 1])))
+        {
+            xstr_mline.insert(0, 1, '\\');
+        }
+
+        std::string::size_type st_cpos = 0;
+        do
+        {
+            if (0 == st_cpos)
+            {
+                // 首行 可能需要以引号包围（续行 不检测行内注释，原样输出）
+                ostr << quote_value(m_xstr_value.substr(0, st_lpos));
+            }
+            else
+            {
+                ostr.write(m_xstr_value.data() + st_cpos,
+                           static_cast< std::streamsize >(st_lpos - st_cpos));
+            }
+
+            if ((0 == st_cpos) && !m_xstr_ncomm.empty())
+            {
+                // 行内注释 写在首行（反斜杠 之后）
+                std::string::size_type st_mpos = ('\\' == xstr_mline[0]) ? 1 : 0;
+                ostr << xstr_mline.substr(0, st_mpos)
+                     << m_xstr_ncomm
+                     << xstr_mline.substr(st_mpos);
+            }
+            else
+            {
+                ostr << xstr_mline;
+            }
+
+            st_cpos = st_lpos + 1;
+            st_lpos = m_xstr_value.find('\n', st_cpos);
+        } while (std::string::npos != st_lpos);
+
+        ostr << m_xstr_value.substr(st_cpos) << std::endl;
+
         return *this;
     }
 
@@ -906,7 +1768,13 @@ public:
      */
     inline const std::string & key(void) const
     {
-        return m_xstr_kname;
+        if (NULL == m_xatom_ptr)
+        {
+            static const std::string xstr_nil;
+            return xstr_nil;
+        }
+
+        return m_xatom_ptr->m_xstr_text;
     }
 
     /**********************************************************/
@@ -933,8 +1801,14 @@ public:
      */
     bool set_key(const std::string & xstr_key)
     {
+        if (!is_writable())
+        {
+            assert(false);
+            return false;
+        }
+
         std::string xstr_kname = trim_xstr(xstr_key);
-        if (check_kname(xstr_kname))
+        if (!check_kname(xstr_kname))
         {
             return false;
         }
@@ -944,35 +1818,145 @@ public:
 
     /**********************************************************/
     /**
-     * @brief 设置键值。
+     * @brief 设置键值（可为多行文本，"\r\n" 视为 "\n"，输出时以续行形式写出）。
      */
     inline void set_value(const std::string & x_value)
     {
-        std::string xstr = x_value.substr(0, x_value.find_first_of("\r\n"));
+        if (is_sline(x_value))
+        {
+            invk_set_value(trim_xstr(x_value));
+            return;
+        }
+
+        std::string xstr;
+        xstr.reserve(x_value.size());
+        for (std::string::const_iterator
+                itstr  = x_value.begin();
+                itstr != x_value.end();
+                ++itstr)
+        {
+            if ('\r' != *itstr)
+                xstr.push_back(*itstr);
+            else if (((itstr + 1) == x_value.end()) || ('\n' != *(itstr + 1)))
+                xstr.push_back('\n');
+        }
+
         invk_set_value(trim_xstr(xstr));
     }
 
+    /**********************************************************/
+    /**
+     * @brief 行内注释（如 “port=80 ; http” 中的 “; http”），无则返回空字符串。
+     */
+    inline std::string comment(void) const
+    {
+        return trim_xstr(m_xstr_ncomm);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 设置行内注释（须以 ';' 或 '#' 开头，空字符串 表示删除行内注释）。
+     */
+    bool set_comment(const std::string & xstr_comment)
+    {
+        if (!is_writable())
+        {
+            assert(false);
+            return false;
+        }
+
+        std::string xstr_ncomm = trim_xstr(xstr_comment);
+        if (!xstr_ncomm.empty())
+        {
+            if (!is_sline(xstr_ncomm) || ((';' != xstr_ncomm[0]) && ('#' != xstr_ncomm[0])))
+            {
+                return false;
+            }
+
+            xstr_ncomm.insert(0, 1, ' ');
+        }
+
+        if (xstr_ncomm != m_xstr_ncomm)
+        {
+            m_xstr_ncomm.swap(xstr_ncomm);
+            set_dirty(true);
+        }
+
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 是否为多行键值。
+     */
+    inline bool is_mline(void) const
+    {
+        return (std::string::npos != m_xstr_value.find('\n'));
+    }
+
     // inner invoking
 protected:
     /**********************************************************/
     /**
-     * @brief 设置（单行文本 且 去除头尾空白字符 的）键值。
+     * @brief 设置（去除头尾空白字符 的）键值。
      */
     inline void invk_set_value(const std::string & xstr_value)
     {
+        if (!is_writable())
+        {
+            assert(false);
+            return;
+        }
+
         if (xstr_value != m_xstr_value)
         {
             m_xstr_value = xstr_value;
+            m_xbt_extern = false;
             set_dirty(true);
+            notify_change(this);
         }
     }
 
-protected:
-    std::string   m_xstr_kname;  ///< 键名
-    std::string   m_xstr_value;  ///< 键值
-};
-
-////////////////////////////////////////////////////////////////////////////////
+public:
+    /**********************************************************/
+    /**
+     * @brief 是否为 包含文件（@include）引入的键值（未被修改过的，不会输出到当前文件）。
+     */
+    inline bool is_extern(void) const { return m_xbt_extern; }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 设置键名（驻留到所属文件的 字符串池 中）。
+     */
+    void set_kname(const std::string & xstr_kname)
+    {
+        set_atom(get_pool()->intern(xstr_kname));
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 设置键名原子（接管 xatom_ptr 的引用，并释放原有的原子）。
+     */
+    inline void set_atom(const xini_atom_t * xatom_ptr)
+    {
+        if (NULL != m_xatom_ptr)
+        {
+            xini_strpool_t::release(m_xatom_ptr);
+        }
+        m_xatom_ptr = xatom_ptr;
+    }
+
+protected:
+    bool          m_xbt_extern;  ///< 是否为 包含文件 引入的键值（置于首位，占用 基类尾部 的填充字节）
+    const xini_atom_t * m_xatom_ptr; ///< 键名（字符串池中的原子）
+    std::string   m_xstr_value;  ///< 键值（多行键值 各行以 '\n' 分隔）
+    std::string   m_xstr_mline;  ///< 多行键值 输出时的续行形式（"\n" 或 "\\\n"，再加上续行缩进）
+    std::string   m_xstr_ncomm;  ///< 行内注释（含其前面的空白字符）
+};
+
+////////////////////////////////////////////////////////////////////////////////
 // xini_section_t
 
 /**
@@ -981,16 +1965,140 @@ protected:
  */
 class xini_section_t : public xini_node_t
 {
+    friend class xini_node_t;
     friend class xini_file_t;
     friend class xini_keyvalue_t;
 
     // common data types
 protected:
-    typedef std::list< xini_node_t * >                              xlst_node_t;
-    typedef std::map< std::string, xini_keyvalue_t *, xstr_icmp_t > xmap_ndkv_t;
+    typedef std::list< xini_node_t * > xlst_node_t;
+
+    /**
+     * @struct xkpos_t
+     * @brief  键值节点 映射表 的索引项：记录节点 以及 其在节点表中的位置，
+     *         删除节点时，无需再遍历节点表。
+     */
+    struct xkpos_t
+    {
+        xini_keyvalue_t     * m_xndkv_ptr;   ///< 键值节点
+        xlst_node_t::iterator m_xiter_node;  ///< 键值节点 在 节点表 中的位置
+        size_t                m_xst_kvec;    ///< 键值节点 在 键值序列 中的位置
+
+        xkpos_t(xini_keyvalue_t * xndkv_ptr,
+                xlst_node_t::iterator xiter_node,
+                size_t xst_kvec)
+            : m_xndkv_ptr(xndkv_ptr)
+            , m_xiter_node(xiter_node)
+            , m_xst_kvec(xst_kvec)
+        {
+
+        }
+    };
+
+    /**
+     * @struct xatom_icmp_t
+     * @brief  键值节点 映射表 的排序（忽略大小写）：
+     *         同一字符串池中的两个原子，小写形式的原子相同 即为相等，只比较指针。
+     */
+    struct xatom_icmp_t
+    {
+        bool operator () (const xini_atom_t * xatom_left,
+                          const xini_atom_t * xatom_right) const
+        {
+            if ((xatom_left->m_xfold_ptr == xatom_right->m_xfold_ptr) &&
+                (NULL != xatom_left->m_xfold_ptr))
+            {
+                return false;
+            }
+
+            return (xstr_icmp(xatom_left->m_xszt_text, xatom_right->m_xszt_text) < 0);
+        }
+    };
+
+    typedef std::map< const xini_atom_t *, xkpos_t, xatom_icmp_t > xmap_ndkv_t;
+    typedef std::vector< xini_keyvalue_t * >                       xvec_ndkv_t;
+
 public:
-    typedef xlst_node_t::iterator       iterator;
-    typedef xlst_node_t::const_iterator const_iterator;
+    /**
+     * @class xkv_iter_t
+     * @brief 键值序列 的迭代器：删除键值时只将其所在位置置空（见 erase_kvec()），
+     *        迭代时跳过这些空位。
+     */
+    template< typename __iter_type >
+    class xkv_iter_t
+    {
+        template< typename > friend class xkv_iter_t;
+
+    public:
+        typedef std::forward_iterator_tag  iterator_category;
+        typedef xini_keyvalue_t *          value_type;
+        typedef std::ptrdiff_t             difference_type;
+        typedef xini_keyvalue_t * const *  pointer;
+        typedef xini_keyvalue_t * const &  reference;
+
+    public:
+        xkv_iter_t(void) { }
+
+        xkv_iter_t(__iter_type xiter, __iter_type xiter_end)
+            : m_xiter(xiter)
+            , m_xiter_end(xiter_end)
+        {
+            skip_null();
+        }
+
+        /** 由 kv_iterator 转换为 kv_const_iterator */
+        template< typename __other_type >
+        xkv_iter_t(const xkv_iter_t< __other_type > & xiter)
+            : m_xiter(xiter.m_xiter)
+            , m_xiter_end(xiter.m_xiter_end)
+        {
+
+        }
+
+    public:
+        inline reference operator * (void) const { return *m_xiter; }
+        inline pointer operator -> (void) const { return &*m_xiter; }
+
+        inline xkv_iter_t & operator ++ (void)
+        {
+            ++m_xiter;
+            skip_null();
+            return *this;
+        }
+
+        inline xkv_iter_t operator ++ (int)
+        {
+            xkv_iter_t xiter(*this);
+            ++*this;
+            return xiter;
+        }
+
+        inline bool operator == (const xkv_iter_t & xiter) const
+        {
+            return (m_xiter == xiter.m_xiter);
+        }
+
+        inline bool operator != (const xkv_iter_t & xiter) const
+        {
+            return (m_xiter != xiter.m_xiter);
+        }
+
+    private:
+        inline void skip_null(void)
+        {
+            while ((m_xiter != m_xiter_end) && (NULL == *m_xiter))
+                ++m_xiter;
+        }
+
+    private:
+        __iter_type m_xiter;     ///< 当前位置
+        __iter_type m_xiter_end; ///< 结束位置
+    };
+
+    typedef xlst_node_t::iterator                         iterator;
+    typedef xlst_node_t::const_iterator                   const_iterator;
+    typedef xkv_iter_t< xvec_ndkv_t::iterator >           kv_iterator;
+    typedef xkv_iter_t< xvec_ndkv_t::const_iterator >     kv_const_iterator;
 
     // common invoking
 protected:
@@ -1066,11 +2174,48 @@ protected:
 protected:
     xini_section_t(xini_node_t * xowner_ptr)
         : xini_node_t(XINI_NTYPE_SECTION, xowner_ptr)
+        , m_xbt_extern(false)
+        , m_xst_kdead(0)
+        , m_xref_count(1)
+    {
+
+    }
+
+#ifdef XINI_CXX11
+    /**********************************************************/
+    /**
+     * @brief 移动构造（转移 节点表/映射表，并将各个节点改由新分节持有）。
+     * @note  xobject 的分节名 和 节点表 被转移后，成为空分节。
+     */
+    xini_section_t(xini_section_t && xobject) noexcept
+        : xini_node_t(XINI_NTYPE_SECTION, xobject.m_xowner_ptr)
+        , m_xbt_extern(xobject.m_xbt_extern)
+        , m_xstr_name(std::move(xobject.m_xstr_name))
+        , m_xlst_node(std::move(xobject.m_xlst_node))
+        , m_xmap_ndkv(std::move(xobject.m_xmap_ndkv))
+        , m_xvec_ndkv(std::move(xobject.m_xvec_ndkv))
+        , m_xst_kdead(xobject.m_xst_kdead)
+        , m_xref_count(1)
     {
+        xobject.m_xlst_node.clear();
+        xobject.m_xmap_ndkv.clear();
+        xobject.m_xvec_ndkv.clear();
+        xobject.m_xst_kdead = 0;
 
+        for (xlst_node_t::iterator
+                itlst  = m_xlst_node.begin();
+                itlst != m_xlst_node.end();
+                ++itlst)
+        {
+            if (&xobject == *itlst)
+                *itlst = this;  // 占位节点
+            else
+                (*itlst)->m_xowner_ptr = this;
+        }
     }
+#endif // XINI_CXX11
 
-    virtual ~xini_section_t(void)
+    ~xini_section_t(void)
     {
         for (std::list< xini_node_t * >::iterator
                 itlst = m_xlst_node.begin();
@@ -1079,12 +2224,14 @@ protected:
         {
             if (XINI_NTYPE_SECTION != (*itlst)->ntype())
             {
-                delete (*itlst);
+                destroy(*itlst);
             }
         }
 
         m_xlst_node.clear();
         m_xmap_ndkv.clear();
+        m_xvec_ndkv.clear();
+        m_xst_kdead = 0;
     }
 
     // 禁用 拷贝构造 和 =负值 操作
@@ -1098,8 +2245,14 @@ public:
     /**
      * @brief 将 节点信息 导向 输出流。
      */
-    virtual const xini_node_t & operator >> (std::ostream & ostr) const
+    const xini_node_t & operator >> (std::ostream & ostr) const
     {
+        // 仅数据 模式 加载的分节 没有占位节点，分节名 直接输出在最前面
+        if (!m_xstr_name.empty() && !has_holder())
+        {
+            ostr << "[" << m_xstr_name << "]" << std::endl;
+        }
+
         for (std::list< xini_node_t * >::const_iterator
                 itlst = m_xlst_node.begin();
              itlst != m_xlst_node.end();
@@ -1113,7 +2266,7 @@ public:
                     ostr << "[" << m_xstr_name << "]" << std::endl;
                 }
             }
-            else
+            else if (!is_extern_knode(*itlst))
             {
                 **itlst >> ostr;
             }
@@ -1128,7 +2281,7 @@ protected:
      * @brief 重命名附属的子节点（键值节点）的索引名。
      * @note  该接口仅由 xini_keyvalue_t::set_key() 调用。
      */
-    virtual bool rename_nsub(
+    bool rename_nsub(
                     xini_node_t * xnsub_ptr,
                     const std::string & xstr_name)
     {
@@ -1159,24 +2312,48 @@ public:
             return *xndkv_ptr;
         }
 
+        // 分节不可写入时，返回 空键值节点（其修改接口 均拒绝写入）
+        if (!is_writable())
+        {
+            assert(false);
+            return const_cast< xini_keyvalue_t & >(nil_knode());
+        }
+
         //======================================
         // 若索引的 键值节点 并未在节点表中，
         // 则 新增 此 键值节点，但并不设置 脏标识，
         // 避免存储不必要的 空键值节点
 
-        xndkv_ptr =
-            static_cast< xini_keyvalue_t * >(
-                xini_keyvalue_t::try_create(xstr_nkey + "=", get_owner()));
-        assert(NULL != xndkv_ptr);
+        xndkv_ptr = new xini_keyvalue_t(this);
+        xndkv_ptr->set_kname(xstr_nkey);
 
-        m_xlst_node.push_back(xndkv_ptr);
-        m_xmap_ndkv.insert(std::make_pair(xstr_nkey, xndkv_ptr));
+        push_knode(xndkv_ptr);
+        notify_change(NULL);
 
         //======================================
 
         return *xndkv_ptr;
     }
 
+    /**********************************************************/
+    /**
+     * @brief 重载 operator [] 操作符，实现 键值 节点的只读索引操作。
+     * @note
+     *  与非 const 版本不同，索引的 键值节点 不存在时，并不新增节点，
+     *  而是返回共享的 空键值节点，整个过程不修改任何内部数据，
+     *  故可在多个线程中并发调用。
+     */
+    const xini_keyvalue_t & operator [] (const std::string & xstr_key) const
+    {
+        const xini_keyvalue_t * xndkv_ptr = find_knode(trim_xstr(xstr_key));
+        if (NULL != xndkv_ptr)
+        {
+            return *xndkv_ptr;
+        }
+
+        return nil_knode();
+    }
+
     // public interfaces
 public:
     /**********************************************************/
@@ -1194,13 +2371,25 @@ public:
      */
     bool set_name(const std::string & xstr_name)
     {
+        if (!is_writable())
+        {
+            assert(false);
+            return false;
+        }
+
         std::string xstr_sname = trim_sname(xstr_name);
         if (!check_sname(xstr_sname))
         {
             return false;
         }
 
-        return get_owner()->rename_nsub(this, xstr_sname);
+        xini_node_t * xowner_ptr = get_owner();
+        if (NULL == xowner_ptr)
+        {
+            return false;
+        }
+
+        return xowner_ptr->rename_nsub(this, xstr_sname);
     }
 
     /**********************************************************/
@@ -1239,17 +2428,162 @@ public:
         return m_xmap_ndkv.empty();
     }
 
+    /**********************************************************/
+    /**
+     * @brief 统计分节所占用的内存（分节对象、其下的各个节点、节点表 与 索引）。
+     * @note  只遍历分节的节点表，不修改任何数据，不影响 读写操作 的开销。
+     */
+    xini_memory_t memory_usage(void) const
+    {
+        xini_memory_t xmem;
+
+        xmem.m_xst_nodes += sizeof(xini_section_t);
+        mem_alloc(xmem);
+        mem_string(xmem, m_xstr_name);
+
+        //======================================
+        // 节点表 与 各个节点
+
+        mem_lnode< xini_node_t * >(xmem, m_xlst_node.size());
+
+        for (xlst_node_t::const_iterator
+                itlst  = m_xlst_node.begin();
+                itlst != m_xlst_node.end();
+                ++itlst)
+        {
+            switch ((*itlst)->ntype())
+            {
+            case XINI_NTYPE_NILLINE:
+                xmem.m_xst_nodes += sizeof(xini_nilline_t);
+                mem_alloc(xmem);
+                break;
+
+            case XINI_NTYPE_COMMENT:
+                xmem.m_xst_nodes += sizeof(xini_comment_t);
+                mem_alloc(xmem);
+                mem_string(xmem, static_cast< const xini_comment_t * >(*itlst)->m_xstr_text);
+                break;
+
+            case XINI_NTYPE_KEYVALUE:
+                {
+                    const xini_keyvalue_t * xndkv_ptr =
+                        static_cast< const xini_keyvalue_t * >(*itlst);
+
+                    xmem.m_xst_nodes += sizeof(xini_keyvalue_t);
+                    mem_alloc(xmem);
+                    mem_string(xmem, xndkv_ptr->m_xstr_value);
+                    mem_string(xmem, xndkv_ptr->m_xstr_mline);
+                    mem_string(xmem, xndkv_ptr->m_xstr_ncomm);
+                }
+                break;
+
+            default:
+                // 分节自身的占位节点，已计入
+                break;
+            }
+        }
+
+        //======================================
+        // 键值映射表（索引键 为键名原子，计入文件的字符串池）与 键值序列
+
+        mem_tnode< xmap_ndkv_t::value_type >(xmem, m_xmap_ndkv.size());
+
+        if (m_xvec_ndkv.capacity() > 0)
+        {
+            xmem.m_xst_indexes += m_xvec_ndkv.capacity() * sizeof(xini_keyvalue_t *);
+            mem_alloc(xmem);
+        }
+
+        return xmem;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 判断当前分节是否与其他 xini_file_t 克隆对象共享（写时复制）。
+     */
+    inline bool is_shared(void) const
+    {
+        return (m_xref_count > 1);
+    }
+
     /**********************************************************/
     /**
      * @brief 判断当前分节是否以空行结尾。
      */
     inline bool has_end_nilline(void) const
     {
-        if (!m_xlst_node.empty() &&
-            (XINI_NTYPE_NILLINE == m_xlst_node.back()->ntype()))
+        // 包含文件引入的键值 不会被输出，跳过
+        for (xlst_node_t::const_reverse_iterator
+                itlst  = m_xlst_node.rbegin();
+                itlst != m_xlst_node.rend();
+                ++itlst)
+        {
+            if (!is_extern_knode(*itlst))
+            {
+                return (XINI_NTYPE_NILLINE == (*itlst)->ntype());
+            }
+        }
+
+        return false;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 判断节点表中是否有 自身的占位节点（仅数据 模式 加载的分节 没有）。
+     * @note  占位节点之前 只可能有 注释/空行 节点，故遇到 键值节点 即可结束查找。
+     */
+    inline bool has_holder(void) const
+    {
+        for (xlst_node_t::const_iterator
+                itlst  = m_xlst_node.begin();
+                itlst != m_xlst_node.end();
+                ++itlst)
+        {
+            if (this == *itlst)
+                return true;
+            if (XINI_NTYPE_KEYVALUE == (*itlst)->ntype())
+                break;
+        }
+
+        return false;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 判断当前分节是否完全由 包含文件（@include）引入（此时不会输出到当前文件）。
+     */
+    inline bool is_extern(void) const
+    {
+        return (m_xbt_extern && !has_output());
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 判断当前分节是否有需要输出的内容（包含文件引入的键值、分节 不输出）。
+     */
+    bool has_output(void) const
+    {
+        if (!m_xstr_name.empty() && !m_xbt_extern && !has_holder())
         {
             return true;
         }
+
+        for (xlst_node_t::const_iterator
+                itlst  = m_xlst_node.begin();
+                itlst != m_xlst_node.end();
+                ++itlst)
+        {
+            if (this == *itlst)
+            {
+                if (!m_xbt_extern)
+                    return true;
+            }
+            else if (!is_extern_knode(*itlst))
+            {
+                return true;
+            }
+        }
+
         return false;
     }
 
@@ -1273,6 +2607,12 @@ public:
      */
     bool key_rename(const std::string & xstr_key, const std::string & xstr_name)
     {
+        if (!is_writable())
+        {
+            assert(false);
+            return false;
+        }
+
         //======================================
 
         xini_keyvalue_t * xndkv_ptr = find_knode(trim_xstr(xstr_key));
@@ -1298,68 +2638,221 @@ public:
      */
     bool key_remove(const std::string & xstr_key)
     {
-        //======================================
-
-        xmap_ndkv_t::iterator itmap = m_xmap_ndkv.find(trim_xstr(xstr_key));
-        if (itmap == m_xmap_ndkv.end())
+        if (!is_writable())
         {
+            assert(false);
             return false;
         }
 
         //======================================
 
-        for (xlst_node_t::iterator
-                itlst  = m_xlst_node.begin();
-                itlst != m_xlst_node.end();
-                ++itlst)
-        {
-            if (XINI_NTYPE_KEYVALUE != (*itlst)->ntype())
-                continue;
-
-            if (static_cast< xini_node_t * >(itmap->second) == (*itlst))
-            {
-                delete *itlst;
-                m_xlst_node.erase(itlst);
+        std::string xstr_nkey = trim_xstr(xstr_key);
+        xini_atom_t xatom_find(xstr_nkey.c_str(), xstr_nkey.size());
 
-                break;
-            }
+        xmap_ndkv_t::iterator itmap = m_xmap_ndkv.find(&xatom_find);
+        if (itmap == m_xmap_ndkv.end())
+        {
+            return false;
         }
 
+        //======================================
+        // 索引项中记录了节点在节点表中的位置，可直接删除
+
+        erase_kvec(itmap->second);
+        delete itmap->second.m_xndkv_ptr;
+        m_xlst_node.erase(itmap->second.m_xiter_node);
         m_xmap_ndkv.erase(itmap);
+        shrink_kvec();
 
         set_dirty(true);
+        notify_change(NULL);
 
         //======================================
 
         return true;
     }
 
-    // iterator
-public:
     /**********************************************************/
     /**
-     * @brief 节点表的起始位置迭代器。
+     * @brief 批量删除满足条件的键值（只遍历一次节点表）。
+     * 
+     * @param [in ] xfunc_pred : 判定函数（对象），原型为 bool (const xini_keyvalue_t &)。
+     * 
+     * @return size_t : 删除的键值数量。
      */
-    inline iterator begin(void) { return m_xlst_node.begin(); }
+    template< typename __pred_type >
+    size_t key_remove_if(__pred_type xfunc_pred)
+    {
+        if (!is_writable())
+        {
+            assert(false);
+            return 0;
+        }
 
-    /**********************************************************/
-    /**
-     * @brief 节点表的起始位置迭代器。
-     */
-    inline const_iterator begin(void) const { return m_xlst_node.begin(); }
+        size_t xst_count = 0;
 
-    /**********************************************************/
-    /**
-     * @brief 节点表的结束位置迭代器。
-     */
-    inline iterator end(void) { return m_xlst_node.end(); }
+        xlst_node_t::iterator itlst = m_xlst_node.begin();
+        while (itlst != m_xlst_node.end())
+        {
+            if (XINI_NTYPE_KEYVALUE != (*itlst)->ntype())
+            {
+                ++itlst;
+                continue;
+            }
 
-    /**********************************************************/
-    /**
-     * @brief 节点表的结束位置迭代器。
+            xini_keyvalue_t * xndkv_ptr = static_cast< xini_keyvalue_t * >(*itlst);
+            if (xfunc_pred(*static_cast< const xini_keyvalue_t * >(xndkv_ptr)))
+            {
+                xmap_ndkv_t::iterator itmap = m_xmap_ndkv.find(xndkv_ptr->m_xatom_ptr);
+                erase_kvec(itmap->second);
+                m_xmap_ndkv.erase(itmap);
+                delete xndkv_ptr;
+                itlst = m_xlst_node.erase(itlst);
+                ++xst_count;
+            }
+            else
+            {
+                ++itlst;
+            }
+        }
+
+        if (xst_count > 0)
+        {
+            shrink_kvec();
+            set_dirty(true);
+            notify_change(NULL);
+        }
+
+        return xst_count;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 枚举键名带有指定前缀（忽略大小写）的键值，如 "db.pool." 。
+     * 
+     * @param [in ] xstr_prefix : 键名前缀（空串则枚举全部键值）。
+     * @param [in ] xfunc_visit : 访问函数（对象），原型为 void (const xini_keyvalue_t &)，
+     *                            按键名（忽略大小写）的升序依次回调。
+     * 
+     * @return size_t : 枚举到的键值数量。
+     */
+    template< typename __func_type >
+    size_t kv_prefix(const std::string & xstr_prefix, __func_type xfunc_visit) const
+    {
+        xmap_ndkv_t::const_iterator itbeg;
+        xmap_ndkv_t::const_iterator itend;
+        xini_atom_t xatom_prefix(xstr_prefix.c_str(), xstr_prefix.size());
+        prefix_range(m_xmap_ndkv, &xatom_prefix, xstr_prefix, itbeg, itend);
+
+        size_t xst_count = 0;
+        for (; itbeg != itend; ++itbeg, ++xst_count)
+        {
+            xfunc_visit(*static_cast< const xini_keyvalue_t * >(itbeg->second.m_xndkv_ptr));
+        }
+
+        return xst_count;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 枚举键名处于 [xstr_lower, xstr_upper) 区间（忽略大小写）的键值。
+     * 
+     * @param [in ] xstr_lower  : 区间下限（包含）。
+     * @param [in ] xstr_upper  : 区间上限（不包含）。
+     * @param [in ] xfunc_visit : 访问函数（对象），原型为 void (const xini_keyvalue_t &)，
+     *                            按键名（忽略大小写）的升序依次回调。
+     * 
+     * @return size_t : 枚举到的键值数量。
+     */
+    template< typename __func_type >
+    size_t kv_range(const std::string & xstr_lower,
+                    const std::string & xstr_upper,
+                    __func_type xfunc_visit) const
+    {
+        if (!xstr_icmp_t()(xstr_lower, xstr_upper))
+        {
+            return 0;
+        }
+
+        xini_atom_t xatom_lower(xstr_lower.c_str(), xstr_lower.size());
+        xini_atom_t xatom_upper(xstr_upper.c_str(), xstr_upper.size());
+
+        xmap_ndkv_t::const_iterator itbeg = m_xmap_ndkv.lower_bound(&xatom_lower);
+        xmap_ndkv_t::const_iterator itend = m_xmap_ndkv.lower_bound(&xatom_upper);
+
+        size_t xst_count = 0;
+        for (; itbeg != itend; ++itbeg, ++xst_count)
+        {
+            xfunc_visit(*static_cast< const xini_keyvalue_t * >(itbeg->second.m_xndkv_ptr));
+        }
+
+        return xst_count;
+    }
+
+    // iterator
+public:
+    /**********************************************************/
+    /**
+     * @brief 节点表的起始位置迭代器。
+     */
+    inline iterator begin(void) { return m_xlst_node.begin(); }
+
+    /**********************************************************/
+    /**
+     * @brief 节点表的起始位置迭代器。
+     */
+    inline const_iterator begin(void) const { return m_xlst_node.begin(); }
+
+    /**********************************************************/
+    /**
+     * @brief 节点表的结束位置迭代器。
+     */
+    inline iterator end(void) { return m_xlst_node.end(); }
+
+    /**********************************************************/
+    /**
+     * @brief 节点表的结束位置迭代器。
      */
     inline const_iterator end(void) const { return m_xlst_node.end(); }
 
+    /**********************************************************/
+    /**
+     * @brief 键值序列（按插入次序，只含 键值节点）的起始位置迭代器。
+     * @note  只遍历键值时，应优先于 begin_kv()/next_kv() 使用，
+     *        无需逐个跳过 空行、注释 等节点。
+     */
+    inline kv_iterator kv_begin(void)
+    {
+        return kv_iterator(m_xvec_ndkv.begin(), m_xvec_ndkv.end());
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 键值序列的起始位置迭代器。
+     */
+    inline kv_const_iterator kv_begin(void) const
+    {
+        return kv_const_iterator(m_xvec_ndkv.begin(), m_xvec_ndkv.end());
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 键值序列的结束位置迭代器。
+     */
+    inline kv_iterator kv_end(void)
+    {
+        return kv_iterator(m_xvec_ndkv.end(), m_xvec_ndkv.end());
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 键值序列的结束位置迭代器。
+     */
+    inline kv_const_iterator kv_end(void) const
+    {
+        return kv_const_iterator(m_xvec_ndkv.end(), m_xvec_ndkv.end());
+    }
+
     /**********************************************************/
     /**
      * @brief 返回节点表中 首个 键值节点 的迭代器。
@@ -1418,6 +2911,72 @@ public:
         return xiter_end;
     }
 
+    /**********************************************************/
+    /**
+     * @brief 删除迭代器所指向的节点，并返回其后的下一个节点迭代器。
+     * @note
+     *  遍历过程中删除节点，应使用该接口，形如：
+     *  <pre>
+     *  for (itnode = xsect.begin(); itnode != xsect.end(); )
+     *      itnode = is_useless(*itnode) ? xsect.erase(itnode) : ++itnode;
+     *  </pre>
+     *  其他节点的迭代器不受影响；分节自身的占位节点不可删除，直接跳过。
+     * 
+     * @param [in ] xiter : 目标节点的迭代器（非结束位置）。
+     * 
+     * @return iterator : 下一个节点的迭代器。
+     */
+    iterator erase(iterator xiter)
+    {
+        assert(xiter != m_xlst_node.end());
+
+        if (!is_writable())
+        {
+            assert(false);
+            return ++xiter;
+        }
+
+        xini_node_t * xnode_ptr = *xiter;
+        switch (xnode_ptr->ntype())
+        {
+        case XINI_NTYPE_SECTION:
+            return ++xiter;
+
+        case XINI_NTYPE_KEYVALUE:
+            {
+                xmap_ndkv_t::iterator itmap = m_xmap_ndkv.find(
+                    static_cast< xini_keyvalue_t * >(xnode_ptr)->m_xatom_ptr);
+                erase_kvec(itmap->second);
+                m_xmap_ndkv.erase(itmap);
+                shrink_kvec();
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        destroy(xnode_ptr);
+        set_dirty(true);
+        notify_change(NULL);
+
+        return m_xlst_node.erase(xiter);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 删除迭代器所指向的 键值节点，并返回 下一个 键值节点 的迭代器
+     *        （与 begin_kv()/next_kv() 配合使用）。
+     */
+    iterator erase_kv(iterator xiter)
+    {
+        xiter = erase(xiter);
+        if ((xiter == m_xlst_node.end()) ||
+            (XINI_NTYPE_KEYVALUE == (*xiter)->ntype()))
+            return xiter;
+        return next_kv(xiter);
+    }
+
     // inner invoking
 protected:
     /**********************************************************/
@@ -1438,6 +2997,7 @@ protected:
         if ((XINI_NTYPE_NILLINE == xnode_ptr->ntype()) ||
             (XINI_NTYPE_COMMENT == xnode_ptr->ntype()))
         {
+            xnode_ptr->m_xowner_ptr = this;
             m_xlst_node.push_back(xnode_ptr);
             return true;
         }
@@ -1452,14 +3012,79 @@ protected:
                 return false;
             }
 
-            m_xlst_node.push_back(xnode_ptr);
-            m_xmap_ndkv.insert(std::make_pair(xnode_kvptr->key(), xnode_kvptr));
+            xnode_ptr->m_xowner_ptr = this;
+            push_knode(xnode_kvptr);
             return true;
         }
 
         return false;
     }
 
+    /**********************************************************/
+    /**
+     * @brief 判断节点是否为 包含文件 引入的键值节点。
+     */
+    static inline bool is_extern_knode(const xini_node_t * xnode_ptr)
+    {
+        return ((XINI_NTYPE_KEYVALUE == xnode_ptr->ntype()) &&
+                static_cast< const xini_keyvalue_t * >(xnode_ptr)->is_extern());
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 将 键值节点 加入到 节点表 尾部，并建立索引（调用方须确保键名不重复）。
+     */
+    inline void push_knode(xini_keyvalue_t * xndkv_ptr)
+    {
+        m_xlst_node.push_back(xndkv_ptr);
+        m_xmap_ndkv.insert(std::make_pair(
+            xndkv_ptr->m_xatom_ptr,
+            xkpos_t(xndkv_ptr, --m_xlst_node.end(), m_xvec_ndkv.size())));
+        m_xvec_ndkv.push_back(xndkv_ptr);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 从 键值序列 中移除节点（不释放节点）：索引项中记录了节点在序列中的位置，
+     *        只将该位置置空，O(1) 完成；空位由 shrink_kvec() 统一回收。
+     */
+    inline void erase_kvec(const xkpos_t & xkpos)
+    {
+        assert(m_xvec_ndkv[xkpos.m_xst_kvec] == xkpos.m_xndkv_ptr);
+        m_xvec_ndkv[xkpos.m_xst_kvec] = NULL;
+        ++m_xst_kdead;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 空位达到 键值序列 的一半时，压缩键值序列（保持插入次序），
+     *        并修正索引项中记录的位置；分摊到每次删除操作为 O(log n)。
+     */
+    void shrink_kvec(void)
+    {
+        if ((2 * m_xst_kdead) < m_xvec_ndkv.size())
+        {
+            return;
+        }
+
+        size_t xst_live = 0;
+        for (size_t xst_iter = 0; xst_iter < m_xvec_ndkv.size(); ++xst_iter)
+        {
+            xini_keyvalue_t * xndkv_ptr = m_xvec_ndkv[xst_iter];
+            if (NULL == xndkv_ptr)
+            {
+                continue;
+            }
+
+            m_xvec_ndkv[xst_live] = xndkv_ptr;
+            m_xmap_ndkv.find(xndkv_ptr->m_xatom_ptr)->second.m_xst_kvec = xst_live;
+            ++xst_live;
+        }
+
+        m_xvec_ndkv.resize(xst_live);
+        m_xst_kdead = 0;
+    }
+
     /**********************************************************/
     /**
      * @brief 查找分节下的 键值 节点。
@@ -1472,27 +3097,104 @@ protected:
      */
     xini_keyvalue_t * find_knode(const std::string & xstr_xkey) const
     {
-        xmap_ndkv_t::const_iterator itfind = m_xmap_ndkv.find(xstr_xkey);
+        xini_atom_t xatom_find(xstr_xkey.c_str(), xstr_xkey.size());
+
+        xmap_ndkv_t::const_iterator itfind = m_xmap_ndkv.find(&xatom_find);
         if (itfind != m_xmap_ndkv.end())
         {
-            return itfind->second;
+            return itfind->second.m_xndkv_ptr;
         }
 
         return NULL;
     }
 
+    /**********************************************************/
+    /**
+     * @brief 复制分节（包括分节下的所有节点），用于 xini_file_t 的写时复制操作。
+     * 
+     * @param [in ] xowner_ptr : 新分节的拥有者（分节下的各个节点 由新分节持有）。
+     * 
+     * @return xini_section_t * : 新分节（引用计数为 1）。
+     */
+    xini_section_t * clone_sect(xini_node_t * xowner_ptr) const
+    {
+        xini_section_t * xsect_ptr = new xini_section_t(xowner_ptr);
+        xsect_ptr->m_xstr_name  = m_xstr_name;
+        xsect_ptr->m_xbt_extern = m_xbt_extern;
+        xsect_ptr->m_xvec_ndkv.reserve(m_xmap_ndkv.size());
+
+        for (xlst_node_t::const_iterator
+                itlst  = m_xlst_node.begin();
+                itlst != m_xlst_node.end();
+                ++itlst)
+        {
+            switch ((*itlst)->ntype())
+            {
+            case XINI_NTYPE_SECTION:
+                assert(this == *itlst);
+                xsect_ptr->m_xlst_node.push_back(xsect_ptr);
+                break;
+
+            case XINI_NTYPE_NILLINE:
+                xsect_ptr->m_xlst_node.push_back(new xini_nilline_t(xsect_ptr));
+                break;
+
+            case XINI_NTYPE_COMMENT:
+                {
+                    xini_comment_t * xnode_ptr = new xini_comment_t(xsect_ptr);
+                    xnode_ptr->m_xstr_text =
+                        static_cast< const xini_comment_t * >(*itlst)->text();
+                    xsect_ptr->m_xlst_node.push_back(xnode_ptr);
+                }
+                break;
+
+            case XINI_NTYPE_KEYVALUE:
+                {
+                    const xini_keyvalue_t * xndkv_ptr =
+                        static_cast< const xini_keyvalue_t * >(*itlst);
+
+                    xini_keyvalue_t * xnode_ptr = new xini_keyvalue_t(xsect_ptr);
+                    xnode_ptr->set_atom(xini_strpool_t::retain(xndkv_ptr->m_xatom_ptr));
+                    xnode_ptr->m_xstr_value = xndkv_ptr->m_xstr_value;
+                    xnode_ptr->m_xstr_mline = xndkv_ptr->m_xstr_mline;
+                    xnode_ptr->m_xstr_ncomm = xndkv_ptr->m_xstr_ncomm;
+                    xnode_ptr->m_xbt_extern = xndkv_ptr->m_xbt_extern;
+                    xsect_ptr->push_knode(xnode_ptr);
+                }
+                break;
+
+            default:
+                assert(false);
+                break;
+            }
+        }
+
+        return xsect_ptr;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 只读索引操作 中 未命中时返回的 空键值节点。
+     */
+    static const xini_keyvalue_t & nil_knode(void)
+    {
+        static const xini_keyvalue_t xnil_knode(NULL);
+        return xnil_knode;
+    }
+
     /**********************************************************/
     /**
      * @brief 从 节点表 尾部取出 非当前 分节 下的注释节点（按 空行 节点作为分界）。
      * 
-     * @param [in ] xlst_comm : 接收返回的注释节点表（在链表头部添加返回的节点）。
-     * @param [in ] xbt_front : 表明操作是从 xlst_comm 前/后附加返回的节点。
+     * @param [in ] xsect_dst : 接收返回的注释节点的分节（取出的节点改由其持有）。
+     * @param [in ] xbt_front : 表明操作是从 xsect_dst 节点表 前/后附加返回的节点。
      * 
      * @return size_t
      *         - 返回取出的节点数量。
      */
-    size_t pop_tail_comment(std::list< xini_node_t * > & xlst_comm, bool xbt_front)
+    size_t pop_tail_comment(xini_section_t * xsect_dst, bool xbt_front)
     {
+        std::list< xini_node_t * > & xlst_comm = xsect_dst->m_xlst_node;
         std::list< xini_node_t * > xlst_node;
 
         size_t xst_line =  0;
@@ -1541,6 +3243,14 @@ protected:
         size_t xst_count = xlst_node.size();
         if (xst_count > 0)
         {
+            for (xlst_node_t::iterator
+                    itlst  = xlst_node.begin();
+                    itlst != xlst_node.end();
+                    ++itlst)
+            {
+                (*itlst)->m_xowner_ptr = xsect_dst;
+            }
+
             // 设置返回结果
             if (xbt_front)
             {
@@ -1586,11 +3296,17 @@ protected:
         // 先从映射表中移除旧有的键值节点映射，
         // 再对键值节点进行重命名，最后重新加入到映射表中
 
-        m_xmap_ndkv.erase(xndkv_ptr->key());
-        xndkv_ptr->m_xstr_kname = xstr_name;
-        m_xmap_ndkv.insert(std::make_pair(xndkv_ptr->key(), xndkv_ptr));
+        xmap_ndkv_t::iterator itmap = m_xmap_ndkv.find(xndkv_ptr->m_xatom_ptr);
+        assert(itmap != m_xmap_ndkv.end());
+        xkpos_t xkpos = itmap->second;
+
+        m_xmap_ndkv.erase(itmap);
+        xndkv_ptr->set_kname(xstr_name);
+        xndkv_ptr->m_xbt_extern = false;
+        m_xmap_ndkv.insert(std::make_pair(xndkv_ptr->m_xatom_ptr, xkpos));
 
         set_dirty(true);
+        notify_change(NULL);
 
         //======================================
 
@@ -1598,9 +3314,13 @@ protected:
     }
 
 protected:
+    bool          m_xbt_extern; ///< 是否由 包含文件 引入的分节（置于首位，占用 基类尾部 的填充字节）
     std::string   m_xstr_name;  ///< 分节名称
     xlst_node_t   m_xlst_node;  ///< 分节下的节点表
     xmap_ndkv_t   m_xmap_ndkv;  ///< 分节下的 键值节点 映射表
+    xvec_ndkv_t   m_xvec_ndkv;  ///< 分节下的 键值节点 序列（按插入次序，已删除的位置为 NULL）
+    size_t        m_xst_kdead;  ///< 键值节点 序列中的空位数量
+    xini_refcnt_t m_xref_count; ///< 引用计数（被多个 xini_file_t 克隆对象共享时大于 1）
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1612,73 +3332,411 @@ protected:
  */
 class xini_file_t : public xini_node_t
 {
+    friend class xini_node_t;
     friend class xini_section_t;
 
     // common data types
 protected:
-    typedef std::list< xini_section_t * >                          xlst_section_t;
-    typedef std::map< std::string, xini_section_t *, xstr_icmp_t > xmap_section_t;
-public:
-    typedef xlst_section_t::iterator       iterator;
-    typedef xlst_section_t::const_iterator const_iterator;
+    typedef std::list< xini_section_t * > xlst_section_t;
 
-    // common invoking
-protected:
-    /**********************************************************/
     /**
-     * @brief 依据给定的 INI 文本行，创建相应的节点。
+     * @struct xspos_t
+     * @brief  分节 映射表 的索引项：记录分节 以及 其在分节表中的位置，
+     *         删除分节时，无需再遍历分节表。
      */
-    static xini_node_t *
-                make_node(
-                    const std::string & xstr_line,
-                    xini_file_t * xowner_ptr)
+    struct xspos_t
     {
-        xini_node_t * xnode_ptr = NULL;
-
-#define XTRY_CREATE(nptr, node, owner)                 \
-        do                                             \
-        {                                              \
-            nptr = node::try_create(xstr_line, owner); \
-            if (NULL != nptr)                          \
-                return nptr;                           \
-        } while (0)
+        xini_section_t         * m_xsect_ptr;   ///< 分节
+        xlst_section_t::iterator m_xiter_sect;  ///< 分节 在 分节表 中的位置
 
-        XTRY_CREATE(xnode_ptr, xini_nilline_t , xowner_ptr);
-        XTRY_CREATE(xnode_ptr, xini_comment_t , xowner_ptr);
-        XTRY_CREATE(xnode_ptr, xini_section_t , xowner_ptr);
-        XTRY_CREATE(xnode_ptr, xini_keyvalue_t, xowner_ptr);
+        xspos_t(xini_section_t * xsect_ptr, xlst_section_t::iterator xiter_sect)
+            : m_xsect_ptr(xsect_ptr)
+            , m_xiter_sect(xiter_sect)
+        {
 
-#undef XTRY_CREATE
+        }
+    };
 
-        return xnode_ptr;
-    }
+    typedef std::map< std::string, xspos_t, xstr_icmp_t > xmap_section_t;
 
-    // constructor/destructor
-public:
-    xini_file_t(void)
-        : xini_node_t(XINI_NTYPE_FILEROOT, NULL)
-        , m_xbt_dirty(false)
+    /**
+     * @struct xsect_table_t
+     * @brief  分节表（可在多个 xini_file_t 克隆对象之间共享，写时复制）。
+     * @note
+     *  分节表 同时是其中各个分节的持有者（分节 -> 分节表 -> 文件），
+     *  移动文件对象时 只需修改分节表的持有者，无需逐个修改分节；
+     *  文件对象析构 或 放弃分节表 时，持有者置为 NULL，分节不会指向已析构的文件。
+     */
+    struct xsect_table_t : public xini_node_t
     {
+        xini_refcnt_t  m_xref_count;  ///< 引用计数
+        xlst_section_t m_xlst_sect;   ///< 文件根下的 分节 节点表
+        xmap_section_t m_xmap_sect;   ///< 各个 分节 的节点映射表
 
-    }
+        xsect_table_t(xini_node_t * xowner_ptr)
+            : xini_node_t(XINI_NTYPE_SECTTBL, xowner_ptr)
+            , m_xref_count(1)
+        {
 
-    xini_file_t(const std::string & xstr_filepath)
-        : xini_node_t(XINI_NTYPE_FILEROOT, NULL)
-        , m_xbt_dirty(false)
-    {
-        load(xstr_filepath);
-    }
+        }
+
+        inline void set_owner(xini_node_t * xowner_ptr) { m_xowner_ptr = xowner_ptr; }
+    };
 
 public:
-    virtual ~xini_file_t(void)
+    /**
+     * @class xsect_iter_t
+     * @brief 分节表 的迭代器：解引用时才将所指分节转为当前对象独占（写时复制），
+     *        遍历过程中未被访问的分节 不会被复制。
+     */
+    class xsect_iter_t
     {
-        release();
-    }
+        friend class xini_file_t;
 
-    // 禁用 拷贝构造 和 =负值 操作
-private:
-    xini_file_t(const xini_file_t & xobject);
-    xini_file_t & operator = (const xini_file_t & xobject);
+    public:
+        typedef std::bidirectional_iterator_tag  iterator_category;
+        typedef xini_section_t *                 value_type;
+        typedef std::ptrdiff_t                   difference_type;
+        typedef xini_section_t * const *         pointer;
+        typedef xini_section_t * const &         reference;
+
+    public:
+        xsect_iter_t(void) : m_xfile_ptr(NULL) { }
+
+        xsect_iter_t(xini_file_t * xfile_ptr, xlst_section_t::iterator xiter)
+            : m_xfile_ptr(xfile_ptr)
+            , m_xiter(xiter)
+        {
+
+        }
+
+        /** 转换为 const_iterator */
+        inline operator xlst_section_t::const_iterator (void) const { return m_xiter; }
+
+    public:
+        inline reference operator * (void) const
+        {
+            m_xfile_ptr->touch_sect(m_xiter);
+            return *m_xiter;
+        }
+
+        inline pointer operator -> (void) const { return &**this; }
+
+        inline xsect_iter_t & operator ++ (void) { ++m_xiter; return *this; }
+        inline xsect_iter_t & operator -- (void) { --m_xiter; return *this; }
+
+        inline xsect_iter_t operator ++ (int)
+        {
+            xsect_iter_t xiter(*this);
+            ++m_xiter;
+            return xiter;
+        }
+
+        inline xsect_iter_t operator -- (int)
+        {
+            xsect_iter_t xiter(*this);
+            --m_xiter;
+            return xiter;
+        }
+
+        inline bool operator == (const xsect_iter_t & xiter) const
+        {
+            return (m_xiter == xiter.m_xiter);
+        }
+
+        inline bool operator != (const xsect_iter_t & xiter) const
+        {
+            return (m_xiter != xiter.m_xiter);
+        }
+
+    private:
+        xini_file_t            * m_xfile_ptr;  ///< 所属文件
+        xlst_section_t::iterator m_xiter;      ///< 在分节表中的位置
+    };
+
+    typedef xsect_iter_t                   iterator;
+    typedef xlst_section_t::const_iterator const_iterator;
+
+protected:
+    /**
+     * @struct xinc_stat_t
+     * @brief  包含文件（@include）的状态，用于判定 解析缓存 是否仍然有效。
+     */
+    struct xinc_stat_t
+    {
+        std::string m_xstr_path;   ///< 文件路径
+        long long   m_xll_mtime;   ///< 最后修改时间
+        long long   m_xll_fsize;   ///< 文件大小
+    };
+
+    typedef std::vector< std::string > xvec_path_t;
+    typedef std::vector< xinc_stat_t > xvec_stat_t;
+
+    /**
+     * @struct xinc_item_t
+     * @brief  解析过程中遇到的 包含指令。
+     */
+    struct xinc_item_t
+    {
+        std::string m_xstr_path;   ///< 包含文件的完整路径
+        std::string m_xstr_real;   ///< 规范化后的路径（用于检测循环包含）
+        std::string m_xstr_sect;   ///< 包含指令所在的分节
+    };
+
+    typedef std::vector< xinc_item_t > xvec_item_t;
+
+    /**
+     * @struct xinc_cache_t
+     * @brief  包含文件 的解析缓存项（进程内共享）。
+     */
+    struct xinc_cache_t
+    {
+        xini_file_t * m_xfile_ptr;   ///< 解析结果（只读，通过克隆对象共享）
+        xvec_stat_t   m_xvec_deps;   ///< 文件自身 以及 其嵌套包含的各个文件 的状态
+    };
+
+    typedef std::map< std::string, xinc_cache_t > xmap_cache_t;
+
+    /**
+     * @struct xexpand_t
+     * @brief  键值插值展开的缓存项（依赖图的节点）。
+     */
+    typedef std::set< std::string, xstr_icmp_t > xset_path_t;
+
+    struct xexpand_t
+    {
+        std::string   m_xstr_value;  ///< 展开后的键值
+        xvec_path_t   m_xvec_refs;   ///< 该键值所引用的各个键值（组合名）
+        xset_path_t   m_xset_refby;  ///< 引用了该键值的（已缓存的）各个键值（组合名）
+    };
+
+    typedef std::map< std::string, xexpand_t, xstr_icmp_t > xmap_expand_t;
+
+#ifdef XINI_CXX14
+    typedef std::shared_timed_mutex xmutex_expand_t;
+#elif defined(XINI_CXX11)
+    typedef std::mutex              xmutex_expand_t;
+#endif // XINI_CXX14
+
+    /**
+     * @struct xmem_nop_t
+     * @brief  memory_usage() 中 不关心各个分节统计结果 时使用的访问函数。
+     */
+    struct xmem_nop_t
+    {
+        inline void operator () (const xini_section_t &, const xini_memory_t &) const { }
+    };
+
+    /**
+     * @struct xmem_atom_t
+     * @brief  memory_usage() 中 统计字符串池中各个原子 的访问函数。
+     */
+    struct xmem_atom_t
+    {
+        xini_memory_t & m_xmem;
+
+        xmem_atom_t(xini_memory_t & xmem) : m_xmem(xmem) { }
+
+        inline void operator () (const xini_atom_t & xatom) const
+        {
+            m_xmem.m_xst_indexes += sizeof(xini_atom_t);
+            mem_alloc(m_xmem);
+            mem_string(m_xmem, xatom.m_xstr_text);
+        }
+    };
+
+    // common invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 依据给定的 INI 文本行，创建相应的节点。
+     */
+    static xini_node_t *
+                make_node(
+                    const std::string & xstr_line,
+                    xini_file_t * xowner_ptr)
+    {
+        xini_node_t * xnode_ptr = NULL;
+
+#define XTRY_CREATE(nptr, node, owner)                 \
+        do                                             \
+        {                                              \
+            nptr = node::try_create(xstr_line, owner); \
+            if (NULL != nptr)                          \
+                return nptr;                           \
+        } while (0)
+
+        XTRY_CREATE(xnode_ptr, xini_nilline_t , xowner_ptr);
+        XTRY_CREATE(xnode_ptr, xini_comment_t , xowner_ptr);
+        XTRY_CREATE(xnode_ptr, xini_section_t , xowner_ptr);
+        XTRY_CREATE(xnode_ptr, xini_keyvalue_t, xowner_ptr);
+
+#undef XTRY_CREATE
+
+        return xnode_ptr;
+    }
+
+    // constructor/destructor
+public:
+    xini_file_t(void)
+        : xini_node_t(XINI_NTYPE_FILEROOT, NULL)
+        , m_xbt_dirty(false)
+        , m_xsect_tbl(nil_table())
+        , m_xbt_donly(false)
+        , m_xpool_ptr(new xini_strpool_t())
+        , m_xbt_expand(false)
+    {
+
+    }
+
+    xini_file_t(const std::string & xstr_filepath)
+        : xini_node_t(XINI_NTYPE_FILEROOT, NULL)
+        , m_xbt_dirty(false)
+        , m_xsect_tbl(nil_table())
+        , m_xbt_donly(false)
+        , m_xpool_ptr(new xini_strpool_t())
+        , m_xbt_expand(false)
+    {
+        load(xstr_filepath);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 克隆（拷贝构造）操作，其开销与文件大小无关。
+     * @note
+     *  克隆对象 与 源对象 共享分节表以及各个分节（写时复制），
+     *  只有在某一方修改时，才复制分节表（只复制分节指针）与 被修改的分节；
+     *  只读访问（const 接口）不会触发复制。
+     *  克隆之前取得的 分节/键值 引用，指向的仍是共享的分节，
+     *  经由其写入 会同时修改克隆对象，故这些引用在克隆后只读（写入时 调试版本
+     *  触发断言，发布版本 拒绝写入，参看 xini_node_t::is_writable()）；
+     *  须经由 xini_file_t 重新索引（复制出各自独占的分节）后，再写入。
+     *  克隆对象 不关联文件路径，且没有脏标识，析构时不会回写任何文件；
+     *  需要回写时，须显式调用 set_filepath() 关联文件路径。
+     */
+    xini_file_t(const xini_file_t & xobject)
+        : xini_node_t(XINI_NTYPE_FILEROOT, NULL)
+        , m_xbt_dirty(false)
+        , m_xstr_head(xobject.m_xstr_head)
+        , m_xsect_tbl(xobject.m_xsect_tbl)
+        , m_xbt_donly(xobject.m_xbt_donly)
+        , m_xpool_ptr(xobject.m_xpool_ptr)
+        , m_xbt_expand(false)
+    {
+        ++m_xsect_tbl->m_xref_count;
+        m_xpool_ptr->retain();
+    }
+
+#ifdef XINI_CXX11
+    /**********************************************************/
+    /**
+     * @brief 移动构造：转移 分节表（各个分节 经由分节表 关联到当前对象）。
+     * @note
+     *  只修改 分节表 的持有者，开销与 分节/键值 的数量无关。
+     *  xobject 成为空对象（不会回写文件），改用共享的 空分节表，
+     *  该表在构造 xobject 时已经创建，此处不会分配内存（参看 nil_table()）。
+     */
+    xini_file_t(xini_file_t && xobject) noexcept
+        : xini_node_t(XINI_NTYPE_FILEROOT, NULL)
+        , m_xbt_dirty(xobject.is_dirty())
+        , m_xstr_path(std::move(xobject.m_xstr_path))
+        , m_xstr_head(std::move(xobject.m_xstr_head))
+        , m_xsect_tbl(xobject.m_xsect_tbl)
+        , m_xbt_donly(xobject.m_xbt_donly)
+        , m_xpool_ptr(xobject.m_xpool_ptr)
+        , m_xbt_expand(false)
+    {
+        m_xpool_ptr->retain();
+        xobject.m_xsect_tbl = nil_table();
+        xobject.clear_expand();
+        xobject.m_xstr_path.clear();
+        xobject.m_xstr_head.clear();
+        xobject.set_dirty(false);
+
+        if (&xobject == m_xsect_tbl->get_owner())
+        {
+            m_xsect_tbl->set_owner(this);
+        }
+    }
+#endif // XINI_CXX11
+
+public:
+    ~xini_file_t(void)
+    {
+        release();
+        release_table(m_xsect_tbl, this);
+        m_xpool_ptr->release();
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 赋值操作（克隆，写时复制），常用于 快照回滚。
+     * @note
+     *  原有内容直接丢弃，并不会回写文件；当前对象关联的文件路径保持不变
+     *  （并不采用 xobject 的文件路径），内容已被替换，故设置脏标识，
+     *  若关联了文件路径，release() 时回写的是替换后的内容。
+     */
+    xini_file_t & operator = (const xini_file_t & xobject)
+    {
+        if (this != &xobject)
+        {
+            ++xobject.m_xsect_tbl->m_xref_count;
+            release_table(m_xsect_tbl, this);
+            m_xsect_tbl = xobject.m_xsect_tbl;
+
+            // 分节中的键名原子 来自 xobject 的字符串池，与拷贝构造一致，改用该池
+            xobject.m_xpool_ptr->retain();
+            m_xpool_ptr->release();
+            m_xpool_ptr = xobject.m_xpool_ptr;
+
+            m_xstr_head = xobject.m_xstr_head;
+            m_xbt_donly = xobject.m_xbt_donly;
+            set_dirty(true);
+            clear_expand();
+        }
+
+        return *this;
+    }
+
+#ifdef XINI_CXX11
+    /**********************************************************/
+    /**
+     * @brief 移动赋值（原有内容直接丢弃，并不会回写文件）。
+     * @note  与移动构造相同，只修改 分节表 的持有者，不会分配内存。
+     */
+    xini_file_t & operator = (xini_file_t && xobject) noexcept
+    {
+        if (this != &xobject)
+        {
+            release_table(m_xsect_tbl, this);
+            m_xsect_tbl = xobject.m_xsect_tbl;
+            xobject.m_xsect_tbl = nil_table();
+
+            if (&xobject == m_xsect_tbl->get_owner())
+            {
+                m_xsect_tbl->set_owner(this);
+            }
+
+            xobject.m_xpool_ptr->retain();
+            m_xpool_ptr->release();
+            m_xpool_ptr = xobject.m_xpool_ptr;
+
+            m_xstr_path = std::move(xobject.m_xstr_path);
+            m_xstr_head = std::move(xobject.m_xstr_head);
+            xobject.m_xstr_path.clear();
+            xobject.m_xstr_head.clear();
+            m_xbt_donly = xobject.m_xbt_donly;
+
+            set_dirty(xobject.is_dirty());
+            xobject.set_dirty(false);
+
+            clear_expand();
+            xobject.clear_expand();
+        }
+
+        return *this;
+    }
+#endif // XINI_CXX11
 
     // overrides
 public:
@@ -1686,22 +3744,28 @@ public:
     /**
      * @brief 将 节点信息 导向 输出流。
      */
-    virtual const xini_node_t & operator >> (std::ostream & ostr) const
+    const xini_node_t & operator >> (std::ostream & ostr) const
     {
-        for (std::list< xini_section_t * >::const_iterator
-                itlst = m_xlst_sect.begin();
-             itlst != m_xlst_sect.end();
+        const xlst_section_t & xlst_sect = m_xsect_tbl->m_xlst_sect;
+        const xini_section_t * xlast_ptr = NULL;
+
+        for (xlst_section_t::const_iterator
+                itlst = xlst_sect.begin();
+             itlst != xlst_sect.end();
              ++itlst)
         {
-            if ((*itlst)->empty())
+            // 空分节 以及 完全由包含文件引入的分节，不输出
+            if (!(*itlst)->has_output())
                 continue;
 
-            **itlst >> ostr;
-            if (!(*itlst)->has_end_nilline() &&
-                ((*itlst) != m_xlst_sect.back()))
+            // 分节之间以空行隔开
+            if ((NULL != xlast_ptr) && !xlast_ptr->has_end_nilline())
             {
                 ostr << std::endl;
             }
+
+            **itlst >> ostr;
+            xlast_ptr = *itlst;
         }
 
         return *this;
@@ -1711,27 +3775,75 @@ public:
     /**
      * @brief 脏标识。
      */
-    virtual bool is_dirty(void) const
+    bool is_dirty(void) const
     {
+#ifdef XINI_CXX11
+        return m_xbt_dirty.load(std::memory_order_relaxed);
+#else // !XINI_CXX11
         return m_xbt_dirty;
+#endif // XINI_CXX11
     }
 
     /**********************************************************/
     /**
      * @brief 设置脏标识。
      */
-    virtual void set_dirty(bool x_dirty)
+    void set_dirty(bool x_dirty)
     {
+#ifdef XINI_CXX11
+        // 多个线程同时写不同分节时（参看 xini_sharded_t），
+        // 先读后写，避免各线程反复争抢同一缓存行
+        if (x_dirty != m_xbt_dirty.load(std::memory_order_relaxed))
+            m_xbt_dirty.store(x_dirty, std::memory_order_relaxed);
+#else // !XINI_CXX11
         m_xbt_dirty = x_dirty;
+#endif // XINI_CXX11
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 通知内容变化：键值被修改时，只清除 引用了该键值 的展开缓存；
+     *        分节/键值 的增删 或 重命名，则清除全部展开缓存。
+     */
+    void notify_change(const xini_node_t * xnode_ptr)
+    {
+        if (!has_expand())
+        {
+            return;
+        }
+
+        if (NULL == xnode_ptr)
+        {
+            clear_expand();
+            return;
+        }
+
+        assert(XINI_NTYPE_KEYVALUE == xnode_ptr->ntype());
+        const xini_keyvalue_t * xndkv_ptr = static_cast< const xini_keyvalue_t * >(xnode_ptr);
+        const xini_section_t  * xsect_ptr = static_cast< const xini_section_t * >(xndkv_ptr->get_owner());
+
+#ifdef XINI_CXX11
+        std::lock_guard< xmutex_expand_t > xlock(m_xmutex_expand);
+#endif // XINI_CXX11
+        invalidate_expand(expand_name(xsect_ptr->name(), xndkv_ptr->key()));
     }
 
 protected:
+    /**********************************************************/
+    /**
+     * @brief 键名字符串池。
+     */
+    xini_strpool_t * get_pool(void)
+    {
+        return m_xpool_ptr;
+    }
+
     /**********************************************************/
     /**
      * @brief 重命名附属的子节点（分节节点）的索引名。
      * @note  该接口仅由 xini_section_t::set_name() 调用。
      */
-    virtual bool rename_nsub(
+    bool rename_nsub(
                     xini_node_t * xnsub_ptr,
                     const std::string & xstr_name)
     {
@@ -1748,28 +3860,56 @@ public:
      * @brief 从 输出流 构建 xini_file_t 内容。
      */
     xini_file_t & operator << (std::istream & istr)
+    {
+        return parse_stream(istr, NULL, NULL);
+    }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 从输入流解析 INI 内容（operator << 的实现）。
+     * @note
+     *  形如 “@include path” 的文本行为包含指令：指令行本身保留在节点表中（输出时原样写回），
+     *  所包含文件中的键值，在整个输入流解析完成后 才合并到当前对象，
+     *  且只在对应分节中 尚未存在同名键值 时加入（即 当前文件的键值 优先）；
+     *  包含文件中无分节名的键值，合并到 包含指令 所在的分节。
+     *  合并进来的键值 标记为 is_extern()，不会输出到当前文件，除非之后被修改。
+     *  循环包含（按规范化后的路径判定），以及 嵌套超过 XINI_INCLUDE_DEPTH 层的包含指令，被忽略。
+     * 
+     * @param [in ] istr       : 输入流。
+     * @param [in ] xchain_ptr : 包含链（用于检测循环包含），顶层解析时为 NULL。
+     * @param [out] xdeps_ptr  : 输出所依赖的包含文件的状态，可为 NULL。
+     */
+    xini_file_t & parse_stream(std::istream & istr,
+                               const xvec_path_t * xchain_ptr,
+                               xvec_stat_t * xdeps_ptr)
     {
         //======================================
 
         // 记录当前操作的分节
         xini_section_t * xsect_ptr = NULL;
 
-        if (m_xlst_sect.empty())
+        // 解析过程中遇到的包含指令
+        xvec_item_t xvec_item;
+
+        detach_table();
+        xlst_section_t & xlst_sect = m_xsect_tbl->m_xlst_sect;
+
+        if (xlst_sect.empty())
         {
             // 当前分节表为空，则创建一个空分节名的 分节 节点
+            assert(m_xsect_tbl->m_xmap_sect.empty());
             xsect_ptr = new xini_section_t(this);
-            m_xlst_sect.push_back(xsect_ptr);
-
-            assert(m_xmap_sect.empty());
-            m_xmap_sect.insert(std::make_pair(std::string(""), xsect_ptr));
+            push_sect(xsect_ptr);
         }
         else
         {
             // 取尾部分节作为当前操作的 分节 节点
-            xsect_ptr = m_xlst_sect.back();
+            xsect_ptr = touch_sect(xlst_sect.back());
 
             // 确保尾部分节空行结尾
-            if (!xsect_ptr->has_end_nilline())
+            if (!m_xbt_donly && !xsect_ptr->has_end_nilline())
             {
                 xsect_ptr->push_node(new xini_nilline_t(this));
             }
@@ -1777,14 +3917,24 @@ public:
 
         //======================================
 
+        // 读取 多行键值 的续行时，预读到的下一行
+        std::string xstr_next;
+        bool xbt_next = false;
+
         // 逐行解析 INI 文件，构建节点表
-        while (!istr.eof())
+        while (xbt_next || !istr.eof())
         {
             //======================================
             // 读取文本行
 
             std::string xstr_line;
-            std::getline(istr, xstr_line);
+            if (xbt_next)
+                xstr_line.swap(xstr_next);
+            else
+                std::getline(istr, xstr_line);
+            xbt_next = false;
+
+            std::string::size_type st_indent = xstr_line.find_first_not_of(XCHARS_TRIM);
             xstr_line = trim_xstr(xstr_line);
 
             // 最后一个空行不放到节点表中，避免文件关闭时 持续增加 尾部空行
@@ -1795,6 +3945,33 @@ public:
 
             //======================================
 
+            // 包含指令：原样保留为注释节点，包含文件留待最后合并
+            std::string xstr_include;
+            if (is_include(xstr_line, xstr_include))
+            {
+                if (!m_xbt_donly)
+                {
+                    xini_comment_t * xnode_ptr = new xini_comment_t(this);
+                    xnode_ptr->m_xstr_text = xstr_line;
+                    xsect_ptr->push_node(xnode_ptr);
+                    set_dirty(true);
+                }
+
+                xinc_item_t xitem;
+                xitem.m_xstr_path = include_path(xstr_include);
+                xitem.m_xstr_real = real_path(xitem.m_xstr_path);
+                xitem.m_xstr_sect = xsect_ptr->name();
+                xvec_item.push_back(xitem);
+                continue;
+            }
+
+            // 仅数据 模式：直接丢弃 空行 与 注释
+            if (m_xbt_donly &&
+                (xstr_line.empty() || (';' == xstr_line[0]) || ('#' == xstr_line[0])))
+            {
+                continue;
+            }
+
             // 创建节点
             xini_node_t * xnode_ptr = make_node(xstr_line, this);
             if (NULL == xnode_ptr)
@@ -1802,6 +3979,41 @@ public:
                 continue;
             }
 
+            // 键值节点 可能带有续行（多行键值）
+            if (XINI_NTYPE_KEYVALUE == xnode_ptr->ntype())
+            {
+                // 仅数据 模式 同样丢弃 行内注释
+                if (m_xbt_donly)
+                    std::string().swap(static_cast< xini_keyvalue_t * >(xnode_ptr)->m_xstr_ncomm);
+
+                xbt_next = xini_keyvalue_t::read_mline(
+                                istr,
+                                static_cast< xini_keyvalue_t * >(xnode_ptr),
+                                st_indent,
+                                xstr_next);
+            }
+
+            // 仅数据 模式：分节 不保留占位节点，也无需转移注释
+            if (m_xbt_donly && (XINI_NTYPE_SECTION == xnode_ptr->ntype()))
+            {
+                xini_section_t * xnew_ptr  = static_cast< xini_section_t * >(xnode_ptr);
+                xini_section_t * xfind_ptr = find_sect(xnew_ptr->name());
+                if (NULL == xfind_ptr)
+                {
+                    xnew_ptr->m_xlst_node.clear();
+                    push_sect(xnew_ptr);
+                    xsect_ptr = xnew_ptr;
+                    set_dirty(true);
+                }
+                else
+                {
+                    destroy(xnode_ptr);
+                    xsect_ptr = touch_sect(xfind_ptr);
+                }
+
+                continue;
+            }
+
             // 若为 分节 节点，则加入到分节表中，并更新当前操作的 分节节点
             if (XINI_NTYPE_SECTION == xnode_ptr->ntype())
             {
@@ -1810,7 +4022,7 @@ public:
                               xsect_ptr);
 
                 if (xsect_ptr != static_cast< xini_section_t * >(xnode_ptr))
-                    delete xnode_ptr; // 添加新分节失败，删除该节点
+                    destroy(xnode_ptr); // 添加新分节失败，删除该节点
                 else
                     set_dirty(true);  // 添加新分节成功，设置脏标识
 
@@ -1826,7 +4038,7 @@ public:
             {
                 // 加入分节失败，可能是因为：
                 // 其为 键值 节点，与 分节 节点表中已有的 节点 索引键 冲突
-                delete xnode_ptr;
+                destroy(xnode_ptr);
             }
 
             //======================================
@@ -1834,9 +4046,19 @@ public:
 
         //======================================
 
+        if (!xvec_item.empty())
+        {
+            merge_includes(xvec_item, xchain_ptr, xdeps_ptr);
+        }
+
+        notify_change(NULL);
+
+        //======================================
+
         return *this;
     }
 
+public:
     /**********************************************************/
     /**
      * @brief 重载 operator [] 操作符，实现 分节 索引操作。
@@ -1850,10 +4072,12 @@ public:
 
         //======================================
 
+        detach_table();
+
         xini_section_t * xsect_ptr = find_sect(xstr_name);
         if (NULL != xsect_ptr)
         {
-            return *xsect_ptr;
+            return *touch_sect(xsect_ptr);
         }
 
         //======================================
@@ -1866,37 +4090,59 @@ public:
                 xini_section_t::try_create("[" + xstr_name + "]", this));
         assert(NULL != xsect_ptr);
 
-        m_xlst_sect.push_back(xsect_ptr);
-        m_xmap_sect.insert(std::make_pair(xstr_name, xsect_ptr));
+        push_sect(xsect_ptr);
 
         //======================================
 
         return *xsect_ptr;
     }
 
-    // public interfaces
-public:
     /**********************************************************/
     /**
-     * @brief 从指定路径的文件中加载 INI 内容。
+     * @brief 重载 operator [] 操作符，实现 分节 的只读索引操作。
      * @note
-     *  load() 操作的成功与否，并不影响后续的键值读写操作，
-     *  其只能标示 xini_file_t 对象是否关联可至指定路径
-     *  （本地磁盘 或 远程网络 等的）文件。
-     * 
-     * @param [in ] xstr_text : 文件路径。
-     * 
+     *  索引的分节不存在时，返回共享的 空分节，并不新增分节，
+     *  配合 xini_section_t 的只读索引操作，可在多个线程中并发读取键值：
+     *  const xini_file_t & xini_cref = xini_file;
+     *  int num = xini_cref["分节"]["键"](1000);
+     */
+    const xini_section_t & operator [] (const std::string & xstr_sect) const
+    {
+        const xini_section_t * xsect_ptr =
+            find_sect(xini_section_t::trim_sname(xstr_sect));
+        if (NULL != xsect_ptr)
+        {
+            return *xsect_ptr;
+        }
+
+        return nil_sect();
+    }
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 从指定路径的文件中加载 INI 内容。
+     * @note
+     *  load() 操作的成功与否，并不影响后续的键值读写操作，
+     *  其只能标示 xini_file_t 对象是否关联可至指定路径
+     *  （本地磁盘 或 远程网络 等的）文件。
+     * 
+     * @param [in ] xstr_text : 文件路径。
+     * @param [in ] xbt_donly : 是否以 仅数据 模式 加载，参看 is_data_only() 。
+     * 
      * @return bool
      *         - 成功，返回 true ；
      *         - 失败，返回 false。
      */
-    bool load(const std::string & xstr_filepath)
+    bool load(const std::string & xstr_filepath, bool xbt_donly = false)
     {
         // 先释放当前对象
         release();
 
         // 不管后续操作是否成功，都关联到新指定的 INI 文件路径
         m_xstr_path = xstr_filepath;
+        m_xbt_donly = xbt_donly;
 
         if (xstr_filepath.empty())
         {
@@ -1910,30 +4156,46 @@ public:
             return false;
         }
 
-        // 跳过字符流的头部编码信息（如 utf-8 的 bom 标识）
-        while (!xfile_reader.eof())
-        {
-            int xchar = xfile_reader.get();
-            if (std::iscntrl(xchar) || std::isprint(xchar))
-            {
-                xfile_reader.putback(static_cast< char >(xchar));
-                break;
-            }
-
-            m_xstr_head.push_back(static_cast< char >(xchar));
-        }
-
-        *this << xfile_reader;
-        set_dirty(false);
+        load_stream(xfile_reader);
 
         return true;
     }
 
+    /**********************************************************/
+    /**
+     * @brief 从输入流中加载 INI 内容，并关联到指定的文件路径。
+     * @note
+     *  适用于调用方已经读取了文件内容的场合（如 比对内容摘要 后再解析），
+     *  避免重复读取文件。
+     * 
+     * @param [in ] istr          : 输入流。
+     * @param [in ] xstr_filepath : 关联的文件路径（后续 release() 时的回写路径）。
+     * @param [in ] xbt_donly     : 是否以 仅数据 模式 加载，参看 is_data_only() 。
+     */
+    void load(std::istream & istr, const std::string & xstr_filepath, bool xbt_donly = false)
+    {
+        release();
+        m_xstr_path = xstr_filepath;
+        m_xbt_donly = xbt_donly;
+        load_stream(istr);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 是否以 仅数据 模式 加载。
+     * @note
+     *  仅数据 模式 适用于只读取配置的场合：解析时直接丢弃 空行 与 注释，
+     *  分节 也不保留占位节点，只构建 分节 与 键值，以减少节点数量与内存占用；
+     *  由于原有格式已丢失，release()（以及析构）时不会回写文件，
+     *  但仍可通过 dump() 显式输出（只有 分节 与 键值）。
+     */
+    inline bool is_data_only(void) const { return m_xbt_donly; }
+
     /**********************************************************/
     /**
      * @brief 将当前文件根下的所有节点直接输出到文件中。
      */
-    bool dump(const std::string & xstr_filepath)
+    bool dump(const std::string & xstr_filepath) const
     {
         // 打开文件
         std::ofstream xfile_writer(
@@ -1958,22 +4220,26 @@ public:
     {
         if (is_dirty())
         {
-            dump(m_xstr_path);
+            // 仅数据 模式 已丢弃原有的注释等格式，不回写文件；
+            // 未关联文件路径（如 克隆对象），也不回写
+            if (!m_xbt_donly && !m_xstr_path.empty())
+                dump(m_xstr_path);
             set_dirty(false);
         }
         m_xstr_path.clear();
         m_xstr_head.clear();
+        clear_expand();
 
-        for (std::list< xini_section_t * >::iterator
-                itlst = m_xlst_sect.begin();
-             itlst != m_xlst_sect.end();
-             ++itlst)
+        if (1 == m_xsect_tbl->m_xref_count)
         {
-            delete *itlst;
+            clear_table(m_xsect_tbl);
+        }
+        else
+        {
+            // 分节表仍被其他克隆对象使用，只放弃引用
+            release_table(m_xsect_tbl, this);
+            m_xsect_tbl = nil_table();
         }
-
-        m_xlst_sect.clear();
-        m_xmap_sect.clear();
     }
 
     /**********************************************************/
@@ -1985,13 +4251,59 @@ public:
         return m_xstr_path;
     }
 
+    /**********************************************************/
+    /**
+     * @brief 关联文件路径（不加载文件内容），release() 时回写到该路径。
+     * @note
+     *  克隆对象 默认不关联文件路径，需要将其内容回写时，须调用该接口，
+     *  并设置脏标识（或者 直接调用 dump()）：
+     *  <pre>
+     *  xini_file_t xini_clone = xini_file;
+     *  ...
+     *  xini_clone.set_filepath(xini_file.filepath());
+     *  xini_clone.set_dirty(true);
+     *  </pre>
+     */
+    inline void set_filepath(const std::string & xstr_filepath)
+    {
+        m_xstr_path = xstr_filepath;
+    }
+
     /**********************************************************/
     /**
      * @brief 返回当前分节数量。
      */
     inline size_t sect_count(void) const
     {
-        return m_xlst_sect.size();
+        return m_xsect_tbl->m_xlst_sect.size();
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 判断当前对象是否与其他克隆对象共享分节表（写时复制）。
+     */
+    inline bool is_shared(void) const
+    {
+        return (m_xsect_tbl->m_xref_count > 1);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 解除与其他克隆对象之间的全部共享（复制分节表及共享的分节）。
+     * @note  若当前并未共享任何数据，其开销为 遍历一次分节表。
+     */
+    void detach(void)
+    {
+        detach_table();
+
+        xlst_section_t & xlst_sect = m_xsect_tbl->m_xlst_sect;
+        for (xlst_section_t::iterator
+                itlst  = xlst_sect.begin();
+                itlst != xlst_sect.end();
+                ++itlst)
+        {
+            touch_sect(itlst);
+        }
     }
 
     /**********************************************************/
@@ -2033,7 +4345,8 @@ public:
             return false;
         }
 
-        return rename_sect(xsect_ptr, xstr_sname);
+        detach_table();
+        return rename_sect(touch_sect(find_sect(xsect_ptr->name())), xstr_sname);
     }
 
     /**********************************************************/
@@ -2044,187 +4357,1581 @@ public:
     {
         //======================================
 
-        xmap_section_t::iterator itmap =
-            m_xmap_sect.find(xini_section_t::trim_sname(xstr_sect));
-        if (itmap == m_xmap_sect.end())
+        std::string xstr_name = xini_section_t::trim_sname(xstr_sect);
+        if (NULL == find_sect(xstr_name))
         {
             return false;
         }
 
-        //======================================
+        detach_table();
 
-        for (xlst_section_t::iterator
-                itlst  = m_xlst_sect.begin();
-                itlst != m_xlst_sect.end();
-                ++itlst)
-        {
-            if (itmap->second == (*itlst))
-            {
-                delete *itlst;
-                m_xlst_sect.erase(itlst);
+        xmap_section_t & xmap_sect = m_xsect_tbl->m_xmap_sect;
+        xmap_section_t::iterator itmap = xmap_sect.find(xstr_name);
 
-                break;
-            }
-        }
+        //======================================
+        // 索引项中记录了分节在分节表中的位置，可直接删除
 
-        m_xmap_sect.erase(itmap);
+        release_sect(itmap->second.m_xsect_ptr, m_xsect_tbl);
+        m_xsect_tbl->m_xlst_sect.erase(itmap->second.m_xiter_sect);
+        xmap_sect.erase(itmap);
 
         set_dirty(true);
+        notify_change(NULL);
 
         //======================================
 
         return true;
     }
 
-    // iterator
-public:
     /**********************************************************/
     /**
-     * @brief 分节表的起始位置迭代器。
+     * @brief 批量删除满足条件的分节（只遍历一次分节表）。
+     * 
+     * @param [in ] xfunc_pred : 判定函数（对象），原型为 bool (const xini_section_t &)。
+     * 
+     * @return size_t : 删除的分节数量。
      */
-    inline iterator begin(void) { return m_xlst_sect.begin(); }
+    template< typename __pred_type >
+    size_t sect_remove_if(__pred_type xfunc_pred)
+    {
+        size_t xst_count = 0;
 
-    /**********************************************************/
-    /**
-     * @brief 分节表的起始位置迭代器。
-     */
-    inline const_iterator begin(void) const { return m_xlst_sect.begin(); }
+        detach_table();
 
-    /**********************************************************/
-    /**
-     * @brief 分节表的结束位置迭代器。
-     */
-    inline iterator end(void) { return m_xlst_sect.end(); }
+        xlst_section_t & xlst_sect = m_xsect_tbl->m_xlst_sect;
+        xlst_section_t::iterator itlst = xlst_sect.begin();
+        while (itlst != xlst_sect.end())
+        {
+            if (xfunc_pred(*static_cast< const xini_section_t * >(*itlst)))
+            {
+                m_xsect_tbl->m_xmap_sect.erase((*itlst)->name());
+                release_sect(*itlst, m_xsect_tbl);
+                itlst = xlst_sect.erase(itlst);
+                ++xst_count;
+            }
+            else
+            {
+                ++itlst;
+            }
+        }
+
+        if (xst_count > 0)
+        {
+            set_dirty(true);
+            notify_change(NULL);
+        }
+
+        return xst_count;
+    }
 
     /**********************************************************/
     /**
-     * @brief 分节表的结束位置迭代器。
+     * @brief 枚举分节名带有指定前缀（忽略大小写）的分节。
+     * 
+     * @param [in ] xstr_prefix : 分节名前缀（空串则枚举全部分节）。
+     * @param [in ] xfunc_visit : 访问函数（对象），原型为 void (const xini_section_t &)，
+     *                            按分节名（忽略大小写）的升序依次回调。
+     * 
+     * @return size_t : 枚举到的分节数量。
      */
-    inline const_iterator end(void) const { return m_xlst_sect.end(); }
+    template< typename __func_type >
+    size_t sect_prefix(const std::string & xstr_prefix, __func_type xfunc_visit) const
+    {
+        xmap_section_t::const_iterator itbeg;
+        xmap_section_t::const_iterator itend;
+        prefix_range(m_xsect_tbl->m_xmap_sect, xstr_prefix, xstr_prefix, itbeg, itend);
+
+        size_t xst_count = 0;
+        for (; itbeg != itend; ++itbeg, ++xst_count)
+        {
+            xfunc_visit(*static_cast< const xini_section_t * >(itbeg->second.m_xsect_ptr));
+        }
+
+        return xst_count;
+    }
 
-    // inner invoking
-protected:
     /**********************************************************/
     /**
-     * @brief 查找分节。
+     * @brief 枚举分节名处于 [xstr_lower, xstr_upper) 区间（忽略大小写）的分节。
+     * 
+     * @param [in ] xstr_lower  : 区间下限（包含）。
+     * @param [in ] xstr_upper  : 区间上限（不包含）。
+     * @param [in ] xfunc_visit : 访问函数（对象），原型为 void (const xini_section_t &)，
+     *                            按分节名（忽略大小写）的升序依次回调。
+     * 
+     * @return size_t : 枚举到的分节数量。
      */
-    xini_section_t * find_sect(const std::string & xstr_sect) const
+    template< typename __func_type >
+    size_t sect_range(const std::string & xstr_lower,
+                      const std::string & xstr_upper,
+                      __func_type xfunc_visit) const
     {
-        xmap_section_t::const_iterator itfind = m_xmap_sect.find(xstr_sect);
-        if (itfind != m_xmap_sect.end())
+        if (!xstr_icmp_t()(xstr_lower, xstr_upper))
         {
-            return itfind->second;
+            return 0;
         }
 
-        return NULL;
+        const xmap_section_t & xmap_sect = m_xsect_tbl->m_xmap_sect;
+        xmap_section_t::const_iterator itbeg = xmap_sect.lower_bound(xstr_lower);
+        xmap_section_t::const_iterator itend = xmap_sect.lower_bound(xstr_upper);
+
+        size_t xst_count = 0;
+        for (; itbeg != itend; ++itbeg, ++xst_count)
+        {
+            xfunc_visit(*static_cast< const xini_section_t * >(itbeg->second.m_xsect_ptr));
+        }
+
+        return xst_count;
     }
 
     /**********************************************************/
     /**
-     * @brief 加入新分节（该接口仅由 operator << 调用）。
+     * @brief 统计占用的内存（不含 xini_file_t 对象本身）。
+     * @note
+     *  只在调用时遍历各个分节，平时不做任何统计，不影响 读写操作 的开销。
+     *  与克隆对象共享的 分节表、分节 同样计入（各个克隆对象 分别统计时会重复计入）。
+     */
+    xini_memory_t memory_usage(void) const
+    {
+        return memory_usage(xmem_nop_t());
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 统计占用的内存，并逐个回调各个分节的统计结果。
      * 
-     * @param [in ] xnew_ptr  : 新增分节。
-     * @param [in ] xsect_ptr : 当前操作分节。
+     * @param [in ] xfunc_visit : 访问函数（对象），原型为
+     *                            void (const xini_section_t &, const xini_memory_t &)，
+     *                            按分节在文件中出现的顺序依次回调。
      * 
-     * @return xini_section_t *
-     *         - 返回当前操作分节。
-     *         - 若返回值 != xnew_ptr 则表示操作失败，新增分节和内部分节重名。
+     * @return xini_memory_t : 总计（各个分节、分节表、插值展开缓存 等）。
      */
-    xini_section_t * push_sect(xini_section_t * xnew_ptr,
-                               xini_section_t * xsect_ptr)
+    template< typename __func_type >
+    xini_memory_t memory_usage(__func_type xfunc_visit) const
     {
-        // 查找同名分节
-        xini_section_t * xfind_ptr = find_sect(xnew_ptr->name());
+        xini_memory_t xmem;
 
-        if (NULL == xfind_ptr)
-        {
-            // 不存在同名分节，则将新增分节加入到节点表尾部
-            m_xlst_sect.push_back(xnew_ptr);
-            m_xmap_sect.insert(std::make_pair(xnew_ptr->name(), xnew_ptr));
+        mem_string(xmem, m_xstr_path);
+        mem_string(xmem, m_xstr_head);
 
-            // 将当前操作分节的节点表中的 尾部注释节点，
-            // 全部转移到新增分节的节点表前
-            xsect_ptr->pop_tail_comment(xnew_ptr->m_xlst_node, true);
+        //======================================
+        // 分节表 与 各个分节
 
-            // 将新增分节作为当前操作分节返回
-            xsect_ptr = xnew_ptr;
+        const xsect_table_t * xtable_ptr = m_xsect_tbl;
+
+        xmem.m_xst_indexes += sizeof(xsect_table_t);
+        mem_alloc(xmem);
+        mem_lnode< xini_section_t * >(xmem, xtable_ptr->m_xlst_sect.size());
+        mem_tnode< xmap_section_t::value_type >(xmem, xtable_ptr->m_xmap_sect.size());
+
+        for (xmap_section_t::const_iterator
+                itmap  = xtable_ptr->m_xmap_sect.begin();
+                itmap != xtable_ptr->m_xmap_sect.end();
+                ++itmap)
+        {
+            mem_string(xmem, itmap->first);
         }
-        else if (xfind_ptr != xsect_ptr)
+
+        for (xlst_section_t::const_iterator
+                itlst  = xtable_ptr->m_xlst_sect.begin();
+                itlst != xtable_ptr->m_xlst_sect.end();
+                ++itlst)
         {
-            // 将当前操作分节的节点表中的 尾部注释节点，
-            // 全部转移到同名分节的节点表后
+            xini_memory_t xmem_sect = (*itlst)->memory_usage();
+            xfunc_visit(**itlst, xmem_sect);
+            xmem += xmem_sect;
+        }
 
-            // 保证空行隔开
-            if (!xfind_ptr->has_end_nilline())
-            {
-                xfind_ptr->push_node(new xini_nilline_t(this));  
-            }
+        //======================================
+        // 键名字符串池
 
-            // 增加注释节点
-            xsect_ptr->pop_tail_comment(xfind_ptr->m_xlst_node, false);
+        xmem.m_xst_indexes += sizeof(xini_strpool_t);
+        mem_alloc(xmem);
+        mem_tnode< xini_atom_t * >(xmem, m_xpool_ptr->size());
+        m_xpool_ptr->visit(xmem_atom_t(xmem));
 
-            // 保证空行隔开
-            if (!xfind_ptr->has_end_nilline())
+        //======================================
+        // 插值展开缓存
+
+        if (has_expand())
+        {
+#ifdef XINI_CXX11
+            std::lock_guard< xmutex_expand_t > xlock(m_xmutex_expand);
+#endif // XINI_CXX11
+            mem_tnode< xmap_expand_t::value_type >(xmem, m_xmap_expand.size());
+            for (xmap_expand_t::const_iterator
+                    itmap  = m_xmap_expand.begin();
+                    itmap != m_xmap_expand.end();
+                    ++itmap)
             {
-                xfind_ptr->push_node(new xini_nilline_t(this));
-            }
+                mem_string(xmem, itmap->first);
+                mem_string(xmem, itmap->second.m_xstr_value);
 
-            // 将同名分节作为当前操作分节返回
-            xsect_ptr = xfind_ptr;
+                const xvec_path_t & xvec_refs = itmap->second.m_xvec_refs;
+                if (xvec_refs.capacity() > 0)
+                {
+                    xmem.m_xst_indexes += xvec_refs.capacity() * sizeof(std::string);
+                    mem_alloc(xmem);
+                }
+
+                for (xvec_path_t::const_iterator
+                        itvec  = xvec_refs.begin();
+                        itvec != xvec_refs.end();
+                        ++itvec)
+                {
+                    mem_string(xmem, *itvec);
+                }
+
+                const xset_path_t & xset_refby = itmap->second.m_xset_refby;
+                mem_tnode< std::string >(xmem, xset_refby.size());
+                for (xset_path_t::const_iterator
+                        itset  = xset_refby.begin();
+                        itset != xset_refby.end();
+                        ++itset)
+                {
+                    mem_string(xmem, *itset);
+                }
+            }
         }
 
-        return xsect_ptr;
+        return xmem;
     }
 
     /**********************************************************/
     /**
-     * @brief 对 分节 进行重命名操作。
+     * @brief 读取键值，并展开其中的插值引用。
+     * @note
+     *  引用的形式为 ${分节:键} ，或者 ${键}（引用同一分节下的键），可嵌套引用；
+     *  $${ 表示字面上的 ${ 。引用不存在的键值时，展开为空串；
+     *  循环引用则保留原引用文本，且不缓存涉及循环的展开结果。
+     *  展开结果在首次访问时缓存，并记录键值之间的依赖关系：
+     *  键值被修改时，只有直接或间接引用了它的缓存项失效；
+     *  分节/键值 的增删、重命名，则清除全部缓存。
+     *  插值只在此接口中展开，value() 以及 各个类型转换 返回的仍是原始文本。
+     *  C++14 下，命中缓存时只加读锁，多个线程可同时读取。
      * 
-     * @param [in ] xsect_ptr : 目标操作的分节。
-     * @param [in ] xstr_name : 重新设置分节的名称。
+     * @param [in ] xstr_sect : 分节名。
+     * @param [in ] xstr_key  : 键名。
      * 
-     * @return 重命名操作 是否成功。
+     * @return std::string : 展开后的键值。
      */
-    bool rename_sect(xini_section_t * xsect_ptr, const std::string & xstr_name)
+    std::string expand(const std::string & xstr_sect, const std::string & xstr_key) const
     {
-        //======================================
+        const std::string xstr_nsect = xini_section_t::trim_sname(xstr_sect);
+        const std::string xstr_nkey  = trim_xstr(xstr_key);
 
-        // 与分节原有名称一致，忽略后续操作
-        if (0 == xstr_icmp(xsect_ptr->name().c_str(), xstr_name.c_str()))
-        {
-            return true;
-        }
+        std::string xstr_value;
+        xvec_path_t xvec_stack;
 
-        // 判定所要设置的分节名称，
-        // 与分节表中的其他分节名称 是否重名
-        if (NULL != find_sect(xstr_name))
+#ifdef XINI_CXX14
+        if (has_expand())
         {
-            return false;
+            std::shared_lock< xmutex_expand_t > xlock(m_xmutex_expand);
+            xmap_expand_t::const_iterator itfind =
+                m_xmap_expand.find(expand_name(xstr_nsect, xstr_nkey));
+            if (itfind != m_xmap_expand.end())
+            {
+                return itfind->second.m_xstr_value;
+            }
         }
+#endif // XINI_CXX14
 
-        //======================================
-        // 先从映射表中移除旧有的分节节点映射，
-        // 再对分节进行重命名，最后重新加入到映射表中
+#ifdef XINI_CXX11
+        std::lock_guard< xmutex_expand_t > xlock(m_xmutex_expand);
+#endif // XINI_CXX11
+        expand_value(xstr_nsect, xstr_nkey, xvec_stack, xstr_value);
 
-        m_xmap_sect.erase(xsect_ptr->name());
-        xsect_ptr->m_xstr_name = xstr_name;
-        m_xmap_sect.insert(std::make_pair(xsect_ptr->name(), xsect_ptr));
+        return xstr_value;
+    }
 
-        set_dirty(true);
+    // iterator
+public:
+    /**********************************************************/
+    /**
+     * @brief 分节表的起始位置迭代器。
+     * @note
+     *  若与克隆对象共享分节表，则先复制分节表（只复制分节指针）；
+     *  各个分节 在迭代器解引用时才转为当前对象独占（写时复制），
+     *  只读遍历时应使用 const 版本，遍历期间不可克隆当前对象。
+     */
+    inline iterator begin(void)
+    {
+        detach_table();
+        return iterator(this, m_xsect_tbl->m_xlst_sect.begin());
+    }
 
-        //======================================
+    /**********************************************************/
+    /**
+     * @brief 分节表的起始位置迭代器。
+     */
+    inline const_iterator begin(void) const { return m_xsect_tbl->m_xlst_sect.begin(); }
 
-        return true;
+    /**********************************************************/
+    /**
+     * @brief 分节表的结束位置迭代器。
+     */
+    inline iterator end(void)
+    {
+        detach_table();
+        return iterator(this, m_xsect_tbl->m_xlst_sect.end());
     }
 
-    // data members
-protected:
-    bool              m_xbt_dirty;  ///< 脏标识
-    std::string       m_xstr_path;  ///< 文件路径
-    std::string       m_xstr_head;  ///< 用于存储文件头的编码字符信息（如 utf-8 的 bom 标识）
-    xlst_section_t    m_xlst_sect;  ///< 文件根下的 分节 节点表
-    xmap_section_t    m_xmap_sect;  ///< 各个 分节 的节点映射表
-};
+    /**********************************************************/
+    /**
+     * @brief 分节表的结束位置迭代器。
+     */
+    inline const_iterator end(void) const { return m_xsect_tbl->m_xlst_sect.end(); }
+
+    /**********************************************************/
+    /**
+     * @brief 删除迭代器所指向的分节，并返回其后的下一个分节迭代器。
+     * @note
+     *  遍历过程中删除分节，应使用该接口，形如：
+     *  <pre>
+     *  for (itsect = xini_file.begin(); itsect != xini_file.end(); )
+     *      itsect = (*itsect)->kv_empty() ? xini_file.erase(itsect) : ++itsect;
+     *  </pre>
+     *  其他分节的迭代器不受影响。xiter 须来自非 const 的 begin()/end()，
+     *  且遍历期间不可克隆当前对象（否则迭代器将指向共享的分节表）。
+     * 
+     * @param [in ] xiter : 目标分节的迭代器（非结束位置）。
+     * 
+     * @return iterator : 下一个分节的迭代器。
+     */
+    iterator erase(iterator xiter)
+    {
+        assert(1 == m_xsect_tbl->m_xref_count);
+        assert(xiter.m_xiter != m_xsect_tbl->m_xlst_sect.end());
+
+        // 直接读取分节指针（删除前无需复制共享的分节）
+        xini_section_t * xsect_ptr = *xiter.m_xiter;
+        m_xsect_tbl->m_xmap_sect.erase(xsect_ptr->name());
+        release_sect(xsect_ptr, m_xsect_tbl);
+        set_dirty(true);
+        notify_change(NULL);
+
+        return iterator(this, m_xsect_tbl->m_xlst_sect.erase(xiter.m_xiter));
+    }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 从输入流中加载 INI 内容（跳过头部编码信息，并清除脏标识）。
+     */
+    void load_stream(std::istream & istr,
+                     const xvec_path_t * xchain_ptr = NULL,
+                     xvec_stat_t * xdeps_ptr = NULL)
+    {
+        // 跳过字符流的头部编码信息（如 utf-8 的 bom 标识）
+        while (!istr.eof())
+        {
+            int xchar = istr.get();
+            if (std::char_traits< char >::eof() == xchar)
+            {
+                break;
+            }
+
+            if (std::iscntrl(xchar) || std::isprint(xchar))
+            {
+                istr.putback(static_cast< char >(xchar));
+                break;
+            }
+
+            m_xstr_head.push_back(static_cast< char >(xchar));
+        }
+
+        parse_stream(istr, xchain_ptr, xdeps_ptr);
+        set_dirty(false);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 判断文本行是否为包含指令（形如 “@include path” 或 “@include "path"”）。
+     * 
+     * @param [in ] xstr_line : 已修剪前后端空白字符的文本行。
+     * @param [out] xstr_path : 操作成功时，返回指令中的文件路径。
+     */
+    static bool is_include(const std::string & xstr_line, std::string & xstr_path)
+    {
+        static const std::string xstr_tag("@include");
+
+        if ((xstr_line.size() <= xstr_tag.size()) ||
+            (0 != xstr_line.compare(0, xstr_tag.size(), xstr_tag)) ||
+            !std::isspace(static_cast< unsigned char >(xstr_line[xstr_tag.size()])))
+        {
+            return false;
+        }
+
+        xstr_path = trim_xstr(xstr_line.substr(xstr_tag.size()));
+        if ((xstr_path.size() >= 2) &&
+            ('\"' == xstr_path[0]) && ('\"' == xstr_path[xstr_path.size() - 1]))
+        {
+            xstr_path = xstr_path.substr(1, xstr_path.size() - 2);
+        }
+
+        return !xstr_path.empty();
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 包含文件的完整路径（相对路径 以当前文件所在目录为基准）。
+     */
+    std::string include_path(const std::string & xstr_include) const
+    {
+        if (('/' == xstr_include[0]) || ('\\' == xstr_include[0]) ||
+            ((xstr_include.size() > 1) && (':' == xstr_include[1])))
+        {
+            return xstr_include;
+        }
+
+        std::string::size_type xst_pos = m_xstr_path.find_last_of("/\\");
+        if (std::string::npos == xst_pos)
+        {
+            return xstr_include;
+        }
+
+        return m_xstr_path.substr(0, xst_pos + 1) + xstr_include;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 规范化路径（绝对路径，消除 “.”、“..” 以及 符号链接），失败时（如文件不存在）返回原路径。
+     */
+    static std::string real_path(const std::string & xstr_path)
+    {
+#ifdef _WIN32
+        char * xszt_real = _fullpath(NULL, xstr_path.c_str(), 0);
+#else // !_WIN32
+        char * xszt_real = realpath(xstr_path.c_str(), NULL);
+#endif // _WIN32
+        if (NULL == xszt_real)
+        {
+            return xstr_path;
+        }
+
+        std::string xstr_real(xszt_real);
+        free(xszt_real);
+        return xstr_real;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 读取文件状态（最后修改时间、文件大小）。
+     */
+    static bool include_stat(const std::string & xstr_path, xinc_stat_t & xinc_stat)
+    {
+        struct stat xstat;
+        if (0 != stat(xstr_path.c_str(), &xstat))
+        {
+            return false;
+        }
+
+        xinc_stat.m_xstr_path = xstr_path;
+        xinc_stat.m_xll_mtime = static_cast< long long >(xstat.st_mtime);
+        xinc_stat.m_xll_fsize = static_cast< long long >(xstat.st_size);
+        return true;
+    }
+
+    /**
+     * @struct xinc_table_t
+     * @brief  包含文件的 解析缓存表（进程退出时释放缓存的解析结果）。
+     */
+    struct xinc_table_t
+    {
+#ifdef XINI_CXX11
+        std::mutex   m_xmutex;     ///< 多个线程（并行解析）同时访问缓存表
+        std::map< std::string, std::shared_future< void > > m_xmap_flight; ///< 正在解析的文件（完成时通知等待者）
+#endif // XINI_CXX11
+        xmap_cache_t m_xmap_cache; ///< 以 文件路径 为索引的缓存项
+
+        ~xinc_table_t(void)
+        {
+            for (xmap_cache_t::iterator
+                    itmap  = m_xmap_cache.begin();
+                    itmap != m_xmap_cache.end();
+                    ++itmap)
+            {
+                delete itmap->second.m_xfile_ptr;
+            }
+        }
+    };
+
+#ifdef XINI_CXX11
+    /**
+     * @struct xinc_flight_t
+     * @brief  占用 包含文件 的解析权：析构时（解析完成、失败 或 异常）移除占用标记，并唤醒等待者。
+     */
+    struct xinc_flight_t
+    {
+        xinc_table_t        & m_xinc_table;
+        const std::string   & m_xstr_path;
+        std::promise< void >  m_xpromise;
+
+        xinc_flight_t(xinc_table_t & xinc_table, const std::string & xstr_path)
+            : m_xinc_table(xinc_table)
+            , m_xstr_path(xstr_path)
+        {
+
+        }
+
+        ~xinc_flight_t(void)
+        {
+            {
+                std::lock_guard< std::mutex > xlock(m_xinc_table.m_xmutex);
+                m_xinc_table.m_xmap_flight.erase(m_xstr_path);
+            }
+
+            m_xpromise.set_value();
+        }
+    };
+#endif // XINI_CXX11
+
+    /**********************************************************/
+    /**
+     * @brief 进程内共享的 包含文件 解析缓存表。
+     */
+    static xinc_table_t & include_table(void)
+    {
+        static xinc_table_t xinc_table;
+        return xinc_table;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 获取包含文件的解析结果：缓存项中各个文件的 修改时间、大小 均未变化时，
+     *        直接克隆缓存的解析结果（写时复制，开销与文件大小无关），否则重新解析。
+     * @note
+     *  C++11 下，xbt_wait 为 true 时，同一文件只由一个线程解析，其他线程等待其完成后 读取缓存；
+     *  嵌套解析（调用方自身正在解析某个包含文件）时 xbt_wait 须为 false，
+     *  避免两个线程各自等待对方正在解析的文件。
+     * 
+     * @param [in ] xitem     : 包含指令。
+     * @param [in ] xvec_chain: 包含链（规范化后的路径，不含 xitem）。
+     * @param [in ] xbt_wait  : 该文件正由其他线程解析时，是否等待其完成。
+     * @param [out] xini_file : 解析结果。
+     * @param [out] xvec_deps : 所依赖文件的状态。
+     * 
+     * @return bool : 文件不存在或无法读取时，返回 false 。
+     */
+    static bool fetch_include(const xinc_item_t & xitem,
+                              const xvec_path_t & xvec_chain,
+                              bool xbt_wait,
+                              xini_file_t & xini_file,
+                              xvec_stat_t & xvec_deps)
+    {
+        xinc_table_t      & xinc_table = include_table();
+        const std::string & xstr_path  = xitem.m_xstr_path;
+
+#ifdef XINI_CXX11
+        std::unique_ptr< xinc_flight_t > xflight_ptr;
+#endif // XINI_CXX11
+
+        for (;;)
+        {
+#ifdef XINI_CXX11
+            std::shared_future< void > xflight_wait;
+            {
+                std::lock_guard< std::mutex > xlock(xinc_table.m_xmutex);
+                if (find_include(xstr_path, xini_file, xvec_deps))
+                {
+                    return true;
+                }
+
+                if (xbt_wait)
+                {
+                    std::map< std::string, std::shared_future< void > >::iterator
+                        itfly = xinc_table.m_xmap_flight.find(xstr_path);
+                    if (itfly != xinc_table.m_xmap_flight.end())
+                    {
+                        xflight_wait = itfly->second;
+                    }
+                    else
+                    {
+                        xflight_ptr.reset(new xinc_flight_t(xinc_table, xstr_path));
+                        xinc_table.m_xmap_flight.insert(std::make_pair(
+                            xstr_path, xflight_ptr->m_xpromise.get_future().share()));
+                    }
+                }
+            }
+
+            if (!xflight_wait.valid())
+            {
+                break;
+            }
+
+            // 等待其他线程解析完成后，重新查找缓存
+            xflight_wait.wait();
+#else // !XINI_CXX11
+            (void)xbt_wait;  // 单线程解析，无需等待
+
+            if (find_include(xstr_path, xini_file, xvec_deps))
+            {
+                return true;
+            }
+
+            break;
+#endif // XINI_CXX11
+        }
+
+        //======================================
+        // 解析文件（不持有锁，可与其他包含文件并行解析）
+
+        xinc_stat_t xinc_stat;
+        if (!include_stat(xstr_path, xinc_stat))
+        {
+            return false;
+        }
+
+        std::ifstream xfile_reader(xstr_path.c_str());
+        if (!xfile_reader.is_open())
+        {
+            return false;
+        }
+
+        xvec_path_t xvec_next(xvec_chain);
+        xvec_next.push_back(xitem.m_xstr_real);
+
+        xinc_cache_t xinc_cache;
+        xinc_cache.m_xvec_deps.push_back(xinc_stat);
+        xinc_cache.m_xfile_ptr = new xini_file_t();
+
+        // 包含文件 只用于合并键值，不会输出，以 仅数据 模式 解析
+        xinc_cache.m_xfile_ptr->m_xbt_donly = true;
+        xinc_cache.m_xfile_ptr->m_xstr_path = xstr_path;
+        xinc_cache.m_xfile_ptr->load_stream(xfile_reader, &xvec_next, &xinc_cache.m_xvec_deps);
+        xinc_cache.m_xfile_ptr->m_xstr_path.clear();   // 缓存对象不回写文件
+
+        xini_file = *xinc_cache.m_xfile_ptr;
+        xvec_deps = xinc_cache.m_xvec_deps;
+
+        //======================================
+        // 更新缓存
+
+        {
+#ifdef XINI_CXX11
+            std::lock_guard< std::mutex > xlock(xinc_table.m_xmutex);
+#endif // XINI_CXX11
+
+            xmap_cache_t::iterator itmap = xinc_table.m_xmap_cache.find(xstr_path);
+            if (itmap != xinc_table.m_xmap_cache.end())
+            {
+                delete itmap->second.m_xfile_ptr;
+                itmap->second = xinc_cache;
+            }
+            else
+            {
+                xinc_table.m_xmap_cache.insert(std::make_pair(xstr_path, xinc_cache));
+            }
+        }
+
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 查找包含文件的解析缓存，并校验其是否仍然有效（调用前须已加锁）。
+     */
+    static bool find_include(const std::string & xstr_path,
+                             xini_file_t & xini_file,
+                             xvec_stat_t & xvec_deps)
+    {
+        xinc_table_t & xinc_table = include_table();
+
+        xmap_cache_t::iterator itmap = xinc_table.m_xmap_cache.find(xstr_path);
+        if (itmap != xinc_table.m_xmap_cache.end())
+        {
+            const xvec_stat_t & xvec_stat = itmap->second.m_xvec_deps;
+
+            bool xbt_valid = true;
+            for (size_t xst_iter = 0; xbt_valid && (xst_iter < xvec_stat.size()); ++xst_iter)
+            {
+                xinc_stat_t xinc_stat;
+                xbt_valid = include_stat(xvec_stat[xst_iter].m_xstr_path, xinc_stat) &&
+                            (xinc_stat.m_xll_mtime == xvec_stat[xst_iter].m_xll_mtime) &&
+                            (xinc_stat.m_xll_fsize == xvec_stat[xst_iter].m_xll_fsize);
+            }
+
+            if (xbt_valid)
+            {
+                xini_file = *itmap->second.m_xfile_ptr;
+                xvec_deps = xvec_stat;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 解析并合并各个包含文件（C++11 下，顶层的多个包含文件 由不超过 CPU 核心数 的线程并行解析，
+     *        嵌套的包含文件 在各自的线程中依次解析）。
+     * 
+     * @param [in ] xvec_item  : 解析过程中遇到的包含指令。
+     * @param [in ] xchain_ptr : 包含链（顶层解析时为 NULL）。
+     * @param [out] xdeps_ptr  : 输出所依赖的包含文件的状态，可为 NULL 。
+     */
+    void merge_includes(const xvec_item_t & xvec_item,
+                        const xvec_path_t * xchain_ptr,
+                        xvec_stat_t * xdeps_ptr)
+    {
+        //======================================
+        // 包含链，用于检测循环包含
+
+        xvec_path_t xvec_chain;
+        if (NULL != xchain_ptr)
+            xvec_chain = *xchain_ptr;
+        else if (!m_xstr_path.empty())
+            xvec_chain.push_back(real_path(m_xstr_path));
+
+        const size_t xst_count = xvec_item.size();
+        const bool   xbt_depth = (xvec_chain.size() < XINI_INCLUDE_DEPTH);
+        std::vector< char > xvec_valid(xst_count, 0);
+        for (size_t xst_iter = 0; xst_iter < xst_count; ++xst_iter)
+        {
+            xvec_valid[xst_iter] = xbt_depth &&
+                (xvec_chain.end() == std::find(xvec_chain.begin(),
+                                               xvec_chain.end(),
+                                               xvec_item[xst_iter].m_xstr_real));
+        }
+
+        //======================================
+        // 解析（或从缓存中获取）各个包含文件
+
+        std::vector< xini_file_t > xvec_file(xst_count);
+        std::vector< xvec_stat_t > xvec_deps(xst_count);
+
+        // 只有顶层解析时 等待其他线程正在解析的同一文件（见 fetch_include()）
+        const bool xbt_wait = (NULL == xchain_ptr);
+
+#ifdef XINI_CXX11
+        size_t xst_threads = 1;
+        if (NULL == xchain_ptr)
+        {
+            xst_threads = std::max< size_t >(1, std::thread::hardware_concurrency());
+            xst_threads = std::min(xst_threads, xst_count);
+        }
+
+        std::atomic< size_t > xst_next(0);
+        std::exception_ptr    xexcept_ptr;
+        std::mutex            xmutex_except;
+
+        auto xfunc_fetch = [&]()
+        {
+            size_t xst_iter = 0;
+            while ((xst_iter = xst_next.fetch_add(1)) < xst_count)
+            {
+                if (!xvec_valid[xst_iter])
+                    continue;
+
+                try
+                {
+                    xvec_valid[xst_iter] = fetch_include(xvec_item[xst_iter],
+                                                         xvec_chain,
+                                                         xbt_wait,
+                                                         xvec_file[xst_iter],
+                                                         xvec_deps[xst_iter]);
+                }
+                catch (...)
+                {
+                    xvec_valid[xst_iter] = 0;
+
+                    std::lock_guard< std::mutex > xlock(xmutex_except);
+                    if (!xexcept_ptr)
+                        xexcept_ptr = std::current_exception();
+                }
+            }
+        };
+
+        std::vector< std::thread > xvec_thread;
+        xvec_thread.reserve(xst_threads - 1);
+        for (size_t xst_iter = 1; xst_iter < xst_threads; ++xst_iter)
+        {
+            xvec_thread.emplace_back(xfunc_fetch);
+        }
+
+        xfunc_fetch();
+
+        for (size_t xst_iter = 0; xst_iter < xvec_thread.size(); ++xst_iter)
+        {
+            xvec_thread[xst_iter].join();
+        }
+
+        if (xexcept_ptr)
+        {
+            std::rethrow_exception(xexcept_ptr);
+        }
+#else // !XINI_CXX11
+        for (size_t xst_iter = 0; xst_iter < xst_count; ++xst_iter)
+        {
+            if (xvec_valid[xst_iter])
+            {
+                xvec_valid[xst_iter] = fetch_include(
+                    xvec_item[xst_iter],
+                    xvec_chain,
+                    xbt_wait,
+                    xvec_file[xst_iter],
+                    xvec_deps[xst_iter]);
+            }
+        }
+#endif // XINI_CXX11
+
+        //======================================
+        // 按指令次序合并
+
+        for (size_t xst_iter = 0; xst_iter < xst_count; ++xst_iter)
+        {
+            if (!xvec_valid[xst_iter])
+                continue;
+
+            merge_extern(xvec_file[xst_iter], xvec_item[xst_iter].m_xstr_sect);
+
+            if (NULL != xdeps_ptr)
+            {
+                xdeps_ptr->insert(xdeps_ptr->end(),
+                                  xvec_deps[xst_iter].begin(),
+                                  xvec_deps[xst_iter].end());
+            }
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 将包含文件的键值合并到当前对象（已存在的同名键值 不会被覆盖）。
+     * 
+     * @param [in ] xini_file : 包含文件的解析结果。
+     * @param [in ] xstr_sect : 包含指令所在的分节（接收包含文件中 无分节名的键值）。
+     */
+    void merge_extern(const xini_file_t & xini_file, const std::string & xstr_sect)
+    {
+        for (const_iterator
+                itsect  = xini_file.begin();
+                itsect != xini_file.end();
+                ++itsect)
+        {
+            const xini_section_t * xsrc_ptr = *itsect;
+            if (xsrc_ptr->kv_empty())
+                continue;
+
+            const std::string & xstr_name =
+                xsrc_ptr->name().empty() ? xstr_sect : xsrc_ptr->name();
+
+            xini_section_t * xdst_ptr = find_sect(xstr_name);
+            if (NULL == xdst_ptr)
+            {
+                xdst_ptr = static_cast< xini_section_t * >(
+                    xini_section_t::try_create("[" + xstr_name + "]", this));
+                assert(NULL != xdst_ptr);
+                xdst_ptr->m_xbt_extern = true;
+                push_sect(xdst_ptr);
+            }
+            else
+            {
+                xdst_ptr = touch_sect(xdst_ptr);
+            }
+
+            for (xini_section_t::kv_const_iterator
+                    itkv  = xsrc_ptr->kv_begin();
+                    itkv != xsrc_ptr->kv_end();
+                    ++itkv)
+            {
+                if (NULL != xdst_ptr->find_knode((*itkv)->key()))
+                    continue;
+
+                xini_keyvalue_t * xndkv_ptr = new xini_keyvalue_t(xdst_ptr);
+                xndkv_ptr->set_kname((*itkv)->key());
+                xndkv_ptr->m_xstr_value = (*itkv)->m_xstr_value;
+                xndkv_ptr->m_xstr_mline = (*itkv)->m_xstr_mline;
+                xndkv_ptr->m_xstr_ncomm = (*itkv)->m_xstr_ncomm;
+                xndkv_ptr->m_xbt_extern = true;
+                xdst_ptr->push_knode(xndkv_ptr);
+            }
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 插值展开缓存中使用的 组合名（分节名 + 键名）。
+     */
+    static inline std::string expand_name(const std::string & xstr_sect,
+                                          const std::string & xstr_key)
+    {
+        return (xstr_sect + '\n' + xstr_key);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 是否存在插值展开的缓存。
+     */
+    inline bool has_expand(void) const
+    {
+#ifdef XINI_CXX11
+        return m_xbt_expand.load(std::memory_order_acquire);
+#else // !XINI_CXX11
+        return m_xbt_expand;
+#endif // XINI_CXX11
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 清除全部插值展开的缓存。
+     */
+    void clear_expand(void)
+    {
+        if (!has_expand())
+        {
+            return;
+        }
+
+#ifdef XINI_CXX11
+        std::lock_guard< xmutex_expand_t > xlock(m_xmutex_expand);
+        m_xbt_expand.store(false, std::memory_order_release);
+#else // !XINI_CXX11
+        m_xbt_expand = false;
+#endif // XINI_CXX11
+        m_xmap_expand.clear();
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 清除指定键值 以及 依赖它的各个键值 的展开缓存（调用前须已加锁），
+     *        同时从其所引用的各个键值中 移除指向它的依赖关系。
+     */
+    void invalidate_expand(const std::string & xstr_name)
+    {
+        xmap_expand_t::iterator itmap = m_xmap_expand.find(xstr_name);
+        if (itmap == m_xmap_expand.end())
+        {
+            return;
+        }
+
+        xvec_path_t xvec_refs;
+        xset_path_t xset_refby;
+        xvec_refs.swap(itmap->second.m_xvec_refs);
+        xset_refby.swap(itmap->second.m_xset_refby);
+        m_xmap_expand.erase(itmap);
+
+        for (xvec_path_t::const_iterator
+                itvec  = xvec_refs.begin();
+                itvec != xvec_refs.end();
+                ++itvec)
+        {
+            xmap_expand_t::iterator itref = m_xmap_expand.find(*itvec);
+            if (itref != m_xmap_expand.end())
+            {
+                itref->second.m_xset_refby.erase(xstr_name);
+            }
+        }
+
+        for (xset_path_t::const_iterator
+                itset  = xset_refby.begin();
+                itset != xset_refby.end();
+                ++itset)
+        {
+            invalidate_expand(*itset);
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 展开键值（调用前须已加锁）。
+     * 
+     * @param [in    ] xstr_sect  : 分节名。
+     * @param [in    ] xstr_key   : 键名。
+     * @param [in,out] xvec_stack : 正在展开的键值（组合名），用于检测循环引用。
+     * @param [out   ] xstr_value : 展开结果。
+     * 
+     * @return bool : 展开过程中遇到循环引用时，返回 false（展开结果不缓存）。
+     */
+    bool expand_value(const std::string & xstr_sect,
+                      const std::string & xstr_key,
+                      xvec_path_t & xvec_stack,
+                      std::string & xstr_value) const
+    {
+        const std::string xstr_name = expand_name(xstr_sect, xstr_key);
+
+        //======================================
+        // 命中缓存
+
+        xmap_expand_t::const_iterator itfind = m_xmap_expand.find(xstr_name);
+        if (itfind != m_xmap_expand.end())
+        {
+            xstr_value = itfind->second.m_xstr_value;
+            return true;
+        }
+
+        // 循环引用
+        for (xvec_path_t::const_iterator
+                itvec  = xvec_stack.begin();
+                itvec != xvec_stack.end();
+                ++itvec)
+        {
+            if (0 == xstr_icmp(itvec->c_str(), xstr_name.c_str()))
+            {
+                xstr_value = "${" + xstr_sect + ":" + xstr_key + "}";
+                return false;
+            }
+        }
+
+        //======================================
+        // 逐个展开引用
+
+        const xini_section_t  * xsect_ptr = find_sect(xstr_sect);
+        const xini_keyvalue_t * xndkv_ptr =
+            (NULL != xsect_ptr) ? xsect_ptr->find_knode(xstr_key) : NULL;
+
+        const std::string   xstr_nil;
+        const std::string & xstr_raw = (NULL != xndkv_ptr) ? xndkv_ptr->value() : xstr_nil;
+        std::string xstr_expand;
+        xvec_path_t xvec_refs;
+        bool        xbt_acyclic = true;
+
+        xvec_stack.push_back(xstr_name);
+
+        std::string::size_type xst_pos = 0;
+        while (xst_pos < xstr_raw.size())
+        {
+            std::string::size_type xst_mark = xstr_raw.find('$', xst_pos);
+            if (std::string::npos == xst_mark)
+            {
+                xstr_expand.append(xstr_raw, xst_pos, std::string::npos);
+                break;
+            }
+
+            xstr_expand.append(xstr_raw, xst_pos, xst_mark - xst_pos);
+
+            // $${ 转义为字面上的 ${
+            if (0 == xstr_raw.compare(xst_mark, 3, "$${"))
+            {
+                xstr_expand.append("${");
+                xst_pos = xst_mark + 3;
+                continue;
+            }
+
+            std::string::size_type xst_end = std::string::npos;
+            if (0 == xstr_raw.compare(xst_mark, 2, "${"))
+            {
+                xst_end = xstr_raw.find('}', xst_mark + 2);
+            }
+
+            if (std::string::npos == xst_end)
+            {
+                xstr_expand.push_back('$');
+                xst_pos = xst_mark + 1;
+                continue;
+            }
+
+            // ${分节:键} 或 ${键}
+            std::string xstr_ref = xstr_raw.substr(xst_mark + 2, xst_end - xst_mark - 2);
+            std::string xstr_rsect = xstr_sect;
+            std::string xstr_rkey;
+
+            std::string::size_type xst_colon = xstr_ref.find(':');
+            if (std::string::npos != xst_colon)
+            {
+                xstr_rsect = xini_section_t::trim_sname(xstr_ref.substr(0, xst_colon));
+                xstr_rkey  = trim_xstr(xstr_ref.substr(xst_colon + 1));
+            }
+            else
+            {
+                xstr_rkey  = trim_xstr(xstr_ref);
+            }
+
+            std::string xstr_rvalue;
+            if (expand_value(xstr_rsect, xstr_rkey, xvec_stack, xstr_rvalue))
+            {
+                xvec_refs.push_back(expand_name(xstr_rsect, xstr_rkey));
+            }
+            else
+            {
+                xbt_acyclic = false;
+            }
+
+            xstr_expand.append(xstr_rvalue);
+            xst_pos = xst_end + 1;
+        }
+
+        xvec_stack.pop_back();
+
+        //======================================
+        // 缓存展开结果
+
+        xstr_value.swap(xstr_expand);
+        if (xbt_acyclic)
+        {
+            // 记录依赖关系：被引用的键值变化时，当前键值的缓存随之失效
+            for (xvec_path_t::const_iterator
+                    itvec  = xvec_refs.begin();
+                    itvec != xvec_refs.end();
+                    ++itvec)
+            {
+                xmap_expand_t::iterator itref = m_xmap_expand.find(*itvec);
+                if (itref != m_xmap_expand.end())
+                {
+                    itref->second.m_xset_refby.insert(xstr_name);
+                }
+            }
+
+            xexpand_t & xexpand = m_xmap_expand[xstr_name];
+            xexpand.m_xstr_value = xstr_value;
+            xexpand.m_xvec_refs.swap(xvec_refs);
+#ifdef XINI_CXX11
+            m_xbt_expand.store(true, std::memory_order_release);
+#else // !XINI_CXX11
+            m_xbt_expand = true;
+#endif // XINI_CXX11
+        }
+
+        return xbt_acyclic;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 查找分节。
+     */
+    xini_section_t * find_sect(const std::string & xstr_sect) const
+    {
+        const xmap_section_t & xmap_sect = m_xsect_tbl->m_xmap_sect;
+        xmap_section_t::const_iterator itfind = xmap_sect.find(xstr_sect);
+        if (itfind != xmap_sect.end())
+        {
+            return itfind->second.m_xsect_ptr;
+        }
+
+        return NULL;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 只读索引操作 中 未命中时返回的 空分节。
+     */
+    static const xini_section_t & nil_sect(void)
+    {
+        static const xini_section_t xnil_sect(NULL);
+        return xnil_sect;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 将 分节 加入到 分节表 尾部，并建立索引（调用方须确保分节名不重复）。
+     */
+    inline void push_sect(xini_section_t * xsect_ptr)
+    {
+        xsect_ptr->m_xowner_ptr = m_xsect_tbl;
+
+        xlst_section_t & xlst_sect = m_xsect_tbl->m_xlst_sect;
+        xlst_sect.push_back(xsect_ptr);
+        m_xsect_tbl->m_xmap_sect.insert(std::make_pair(
+            xsect_ptr->name(), xspos_t(xsect_ptr, --xlst_sect.end())));
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 加入新分节（该接口仅由 operator << 调用）。
+     * 
+     * @param [in ] xnew_ptr  : 新增分节。
+     * @param [in ] xsect_ptr : 当前操作分节。
+     * 
+     * @return xini_section_t *
+     *         - 返回当前操作分节。
+     *         - 若返回值 != xnew_ptr 则表示操作失败，新增分节和内部分节重名。
+     */
+    xini_section_t * push_sect(xini_section_t * xnew_ptr,
+                               xini_section_t * xsect_ptr)
+    {
+        // 查找同名分节
+        xini_section_t * xfind_ptr = find_sect(xnew_ptr->name());
+
+        if (NULL == xfind_ptr)
+        {
+            // 不存在同名分节，则将新增分节加入到节点表尾部
+            push_sect(xnew_ptr);
+
+            // 将当前操作分节的节点表中的 尾部注释节点，
+            // 全部转移到新增分节的节点表前
+            xsect_ptr->pop_tail_comment(xnew_ptr, true);
+
+            // 将新增分节作为当前操作分节返回
+            xsect_ptr = xnew_ptr;
+        }
+        else if (xfind_ptr != xsect_ptr)
+        {
+            xfind_ptr = touch_sect(xfind_ptr);
+
+            // 将当前操作分节的节点表中的 尾部注释节点，
+            // 全部转移到同名分节的节点表后
+
+            // 保证空行隔开
+            if (!xfind_ptr->has_end_nilline())
+            {
+                xfind_ptr->push_node(new xini_nilline_t(this));  
+            }
+
+            // 增加注释节点
+            xsect_ptr->pop_tail_comment(xfind_ptr, false);
+
+            // 保证空行隔开
+            if (!xfind_ptr->has_end_nilline())
+            {
+                xfind_ptr->push_node(new xini_nilline_t(this));
+            }
+
+            // 将同名分节作为当前操作分节返回
+            xsect_ptr = xfind_ptr;
+        }
+
+        return xsect_ptr;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 共享的 空分节表（默认构造 或 被移动后 的对象使用，写时复制）。
+     * @note
+     *  其自身持有一个永不释放的引用，故引用计数不会归零。
+     *  首次调用（xini_file_t 的默认构造 或 以文件路径构造）时创建，
+     *  其后只增加引用计数，不会分配内存，也不会抛出异常；
+     *  移动操作的源对象 必然已经构造，故移动操作中调用该接口 不会分配内存。
+     */
+    static xsect_table_t * nil_table(void)
+    {
+        static xsect_table_t * xnil_table = new xsect_table_t(NULL);
+        ++xnil_table->m_xref_count;
+        return xnil_table;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 从 分节表 中移除分节时，释放对 分节 的引用，引用计数归零时删除分节。
+     * @note  分节仍被其他克隆对象共享，且由 xtable_ptr 持有时，将其持有者置为 NULL，
+     *        由下一个写入该分节的对象 重新持有（参看 touch_sect()）。
+     */
+    static void release_sect(xini_section_t * xsect_ptr, xsect_table_t * xtable_ptr)
+    {
+        if (0 == --xsect_ptr->m_xref_count)
+        {
+            delete xsect_ptr;
+        }
+        else if (xtable_ptr == xsect_ptr->m_xowner_ptr)
+        {
+            xsect_ptr->m_xowner_ptr = NULL;
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 释放 分节表 内的所有分节，并清空分节表。
+     */
+    static void clear_table(xsect_table_t * xtable_ptr)
+    {
+        for (xlst_section_t::iterator
+                itlst  = xtable_ptr->m_xlst_sect.begin();
+                itlst != xtable_ptr->m_xlst_sect.end();
+                ++itlst)
+        {
+            release_sect(*itlst, xtable_ptr);
+        }
+
+        xtable_ptr->m_xlst_sect.clear();
+        xtable_ptr->m_xmap_sect.clear();
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 释放 xowner_ptr 对 分节表 的引用，引用计数归零时删除分节表。
+     * @note  分节表仍被其他克隆对象使用，且由 xowner_ptr 持有时，将其持有者置为 NULL。
+     */
+    static void release_table(xsect_table_t * xtable_ptr, const xini_node_t * xowner_ptr)
+    {
+        if (0 == --xtable_ptr->m_xref_count)
+        {
+            clear_table(xtable_ptr);
+            delete xtable_ptr;
+        }
+        else if (xowner_ptr == xtable_ptr->get_owner())
+        {
+            xtable_ptr->set_owner(NULL);
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 若 分节表 与其他克隆对象共享，则复制一份（只复制分节指针）。
+     * @note  调用后 分节表 为当前对象独占，且由当前对象持有。
+     */
+    void detach_table(void)
+    {
+        if (1 == m_xsect_tbl->m_xref_count)
+        {
+            // 共享该分节表的其他对象 已先行析构 时，其持有者为 NULL
+            m_xsect_tbl->set_owner(this);
+            return;
+        }
+
+        // 映射表中的索引项 须指向新分节表中的位置，逐个重建；
+        // 各个分节 仍由原分节表持有，写入时再转为当前对象独占（参看 touch_sect()）
+        xsect_table_t * xtable_ptr = new xsect_table_t(this);
+        xtable_ptr->m_xlst_sect = m_xsect_tbl->m_xlst_sect;
+
+        for (xlst_section_t::iterator
+                itlst  = xtable_ptr->m_xlst_sect.begin();
+                itlst != xtable_ptr->m_xlst_sect.end();
+                ++itlst)
+        {
+            ++(*itlst)->m_xref_count;
+            xtable_ptr->m_xmap_sect.insert(
+                std::make_pair((*itlst)->name(), xspos_t(*itlst, itlst)));
+        }
+
+        release_table(m_xsect_tbl, this);
+        m_xsect_tbl = xtable_ptr;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 确保 分节表 中 itlst 位置的分节 为当前对象独占（写时复制）。
+     * @note
+     *  调用前 分节表 须已为当前对象独占（参看 detach_table()）。
+     *  分节被共享时，复制一份，复制后的分节 由当前对象的分节表持有；
+     *  分节未被共享，但其持有者不是当前对象的分节表（如 源对象 已先行复制了该分节，
+     *  或者已经析构），则直接改由当前对象的分节表持有（分节下的节点由分节持有，无需修改）。
+     * 
+     * @return xini_section_t * : 当前对象独占的分节。
+     */
+    xini_section_t * touch_sect(xlst_section_t::iterator itlst)
+    {
+        assert(1 == m_xsect_tbl->m_xref_count);
+
+        xini_section_t * xsect_ptr = *itlst;
+        if (1 == xsect_ptr->m_xref_count)
+        {
+            xsect_ptr->m_xowner_ptr = m_xsect_tbl;
+            return xsect_ptr;
+        }
+
+        xini_section_t * xnew_ptr = xsect_ptr->clone_sect(m_xsect_tbl);
+        *itlst = xnew_ptr;
+        xmap_section_t::iterator itmap =
+            m_xsect_tbl->m_xmap_sect.find(xnew_ptr->name());
+        assert(itmap != m_xsect_tbl->m_xmap_sect.end());
+        itmap->second.m_xsect_ptr = xnew_ptr;
+        release_sect(xsect_ptr, m_xsect_tbl);
+
+        return xnew_ptr;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 确保指定的分节 为当前对象独占（写时复制）。
+     */
+    xini_section_t * touch_sect(xini_section_t * xsect_ptr)
+    {
+        if ((1 == xsect_ptr->m_xref_count) && (m_xsect_tbl == xsect_ptr->m_xowner_ptr))
+        {
+            return xsect_ptr;
+        }
+
+        // 通过映射表中记录的位置定位分节，无需遍历分节表
+        xmap_section_t::iterator itmap =
+            m_xsect_tbl->m_xmap_sect.find(xsect_ptr->name());
+        assert(itmap != m_xsect_tbl->m_xmap_sect.end());
+        assert(xsect_ptr == itmap->second.m_xsect_ptr);
+
+        return touch_sect(itmap->second.m_xiter_sect);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 对 分节 进行重命名操作。
+     * 
+     * @param [in ] xsect_ptr : 目标操作的分节。
+     * @param [in ] xstr_name : 重新设置分节的名称。
+     * 
+     * @return 重命名操作 是否成功。
+     */
+    bool rename_sect(xini_section_t * xsect_ptr, const std::string & xstr_name)
+    {
+        //======================================
+
+        // 与分节原有名称一致，忽略后续操作
+        if (0 == xstr_icmp(xsect_ptr->name().c_str(), xstr_name.c_str()))
+        {
+            return true;
+        }
+
+        // 判定所要设置的分节名称，
+        // 与分节表中的其他分节名称 是否重名
+        if (NULL != find_sect(xstr_name))
+        {
+            return false;
+        }
+
+        //======================================
+        // 先从映射表中移除旧有的分节节点映射，
+        // 再对分节进行重命名，最后重新加入到映射表中
+
+        xmap_section_t & xmap_sect = m_xsect_tbl->m_xmap_sect;
+        xmap_section_t::iterator itmap = xmap_sect.find(xsect_ptr->name());
+        assert(itmap != xmap_sect.end());
+        xspos_t xspos = itmap->second;
+
+        xmap_sect.erase(itmap);
+        xsect_ptr->m_xstr_name = xstr_name;
+        xmap_sect.insert(std::make_pair(xsect_ptr->name(), xspos));
+
+        set_dirty(true);
+        notify_change(NULL);
+
+        //======================================
+
+        return true;
+    }
+
+    // data members
+protected:
+#ifdef XINI_CXX11
+    std::atomic< bool > m_xbt_dirty;  ///< 脏标识（原子操作，容许多个分节并发写入）
+#else // !XINI_CXX11
+    bool              m_xbt_dirty;  ///< 脏标识
+#endif // XINI_CXX11
+    std::string       m_xstr_path;  ///< 文件路径
+    std::string       m_xstr_head;  ///< 用于存储文件头的编码字符信息（如 utf-8 的 bom 标识）
+    xsect_table_t   * m_xsect_tbl;  ///< 分节表（克隆对象之间写时复制）
+    bool              m_xbt_donly;  ///< 是否以 仅数据 模式 加载（不保留 空行、注释，不回写文件）
+    xini_strpool_t    * m_xpool_ptr;  ///< 键名的字符串池（与克隆对象共享）
+
+    mutable xmap_expand_t  m_xmap_expand;    ///< 键值插值展开的缓存（依赖图）
+#ifdef XINI_CXX11
+    mutable xmutex_expand_t m_xmutex_expand; ///< 保护展开缓存（const 接口 可被多个线程并发调用）
+    mutable std::atomic< bool > m_xbt_expand;  ///< 展开缓存是否非空（避免无缓存时加锁）
+#else // !XINI_CXX11
+    mutable bool           m_xbt_expand;     ///< 展开缓存是否非空
+#endif // XINI_CXX11
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// xini_node_t : 按 ntype() 分派的节点接口（各个节点类 均已完整定义）
+
+inline const xini_node_t & xini_node_t::operator >> (std::ostream & ostr) const
+{
+    switch (m_xini_ntype)
+    {
+    case XINI_NTYPE_NILLINE : *static_cast< const xini_nilline_t  * >(this) >> ostr; break;
+    case XINI_NTYPE_COMMENT : *static_cast< const xini_comment_t  * >(this) >> ostr; break;
+    case XINI_NTYPE_KEYVALUE: *static_cast< const xini_keyvalue_t * >(this) >> ostr; break;
+    case XINI_NTYPE_SECTION : *static_cast< const xini_section_t  * >(this) >> ostr; break;
+    case XINI_NTYPE_FILEROOT: *static_cast< const xini_file_t     * >(this) >> ostr; break;
+    default: assert(false); break;
+    }
+
+    return *this;
+}
+
+inline xini_file_t * xini_node_t::owner_file(void) const
+{
+    const xini_node_t * xnode_ptr = this;
+    while ((NULL != xnode_ptr) && (XINI_NTYPE_FILEROOT != xnode_ptr->m_xini_ntype))
+    {
+        xnode_ptr = xnode_ptr->m_xowner_ptr;
+    }
+
+    return static_cast< xini_file_t * >(const_cast< xini_node_t * >(xnode_ptr));
+}
+
+inline bool xini_node_t::is_writable(void) const
+{
+    for (const xini_node_t * xnode_ptr = this;
+         NULL != xnode_ptr;
+         xnode_ptr = xnode_ptr->m_xowner_ptr)
+    {
+        switch (xnode_ptr->m_xini_ntype)
+        {
+        case XINI_NTYPE_SECTION:
+            if (static_cast< const xini_section_t * >(xnode_ptr)->m_xref_count > 1)
+                return false;
+            break;
+
+        case XINI_NTYPE_SECTTBL:
+            if (static_cast< const xini_file_t::xsect_table_t * >(xnode_ptr)->m_xref_count > 1)
+                return false;
+            break;
+
+        case XINI_NTYPE_FILEROOT:
+            return true;
+
+        default:
+            break;
+        }
+    }
+
+    // 已脱离文件（如 只读索引 返回的空节点）
+    return false;
+}
+
+inline bool xini_node_t::is_dirty(void) const
+{
+    const xini_file_t * xfile_ptr = owner_file();
+    if (NULL != xfile_ptr)
+    {
+        return xfile_ptr->is_dirty();
+    }
+    return false;
+}
+
+inline void xini_node_t::set_dirty(bool x_dirty)
+{
+    xini_file_t * xfile_ptr = owner_file();
+    if (NULL != xfile_ptr)
+    {
+        xfile_ptr->set_dirty(x_dirty);
+    }
+}
+
+inline void xini_node_t::notify_change(const xini_node_t * xnode_ptr)
+{
+    xini_file_t * xfile_ptr = owner_file();
+    if (NULL != xfile_ptr)
+    {
+        xfile_ptr->notify_change(xnode_ptr);
+    }
+}
+
+inline xini_strpool_t * xini_node_t::get_pool(void)
+{
+    xini_file_t * xfile_ptr = owner_file();
+    if (NULL != xfile_ptr)
+    {
+        return xfile_ptr->get_pool();
+    }
+
+    // 无持有者的节点（如 只读索引 返回的空节点），使用进程内共用的字符串池
+    static xini_strpool_t * xpool_ptr = new xini_strpool_t();
+    return xpool_ptr;
+}
+
+inline bool xini_node_t::rename_nsub(xini_node_t * xnsub_ptr, const std::string & xstr_name)
+{
+    switch (m_xini_ntype)
+    {
+    case XINI_NTYPE_SECTION : return static_cast< xini_section_t * >(this)->rename_nsub(xnsub_ptr, xstr_name);
+    case XINI_NTYPE_FILEROOT: return static_cast< xini_file_t    * >(this)->rename_nsub(xnsub_ptr, xstr_name);
+    default: break;
+    }
+
+    return false;
+}
+
+inline void xini_node_t::destroy(xini_node_t * xnode_ptr)
+{
+    switch (xnode_ptr->m_xini_ntype)
+    {
+    case XINI_NTYPE_NILLINE : delete static_cast< xini_nilline_t  * >(xnode_ptr); break;
+    case XINI_NTYPE_COMMENT : delete static_cast< xini_comment_t  * >(xnode_ptr); break;
+    case XINI_NTYPE_KEYVALUE: delete static_cast< xini_keyvalue_t * >(xnode_ptr); break;
+    case XINI_NTYPE_SECTION : delete static_cast< xini_section_t  * >(xnode_ptr); break;
+    default: assert(false); break;
+    }
+}
 
 /**********************************************************/
 /**
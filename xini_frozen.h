@@ -0,0 +1,660 @@
+﻿/**
+ * The MIT License (MIT)
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file xini_frozen.h
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * @author  ：Gaaagaa
+ * @date    : 2026-10-19
+ * @version : 1.0.0.0
+ * @brief   : 由 xini_file_t 冻结而成的只读配置（紧凑存储，最小完美哈希索引）。
+ */
+
+#ifndef __XINI_FROZEN_H__
+#define __XINI_FROZEN_H__
+
+#include "xini_file.h"
+
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// xini_frozen_t
+
+/**
+ * @class xini_frozen_t
+ * @brief 冻结的（只读）配置。
+ *
+ * <pre>
+ * freeze() 将 xini_file_t 中的 分节、键值 压缩存放到连续的数组中：
+ *  字符串池 ：分节名、键名、键值（以 '\0' 结尾，键名 与 键值 相邻存放）；
+ *  分节表   ：分节名 与 键值区间；
+ *  键值表   ：按 最小完美哈希 的槽位存放，槽位号 即 键值表 下标（不记录键值长度，以节省内存）。
+ * 最小完美哈希 为 “哈希-位移” 结构：对（转为小写的）分节名 + 键名 只计算一次哈希值，
+ * 高 32 位选择分桶，低 32 位与分桶的位移值混合后得到槽位，
+ * 查找只需 一次哈希 与 一次比对，不涉及任何树结构。
+ * 
+ * 冻结后 与 原对象 无关联，原对象可以释放；冻结对象之后不能修改，只能重新 freeze() 。
+ *
+ * 使用示例：
+ *  xini_frozen_t xfrozen(xini_file);
+ *  const char * xszt_host = xfrozen.find("db", "host");
+ * </pre>
+ */
+class xini_frozen_t
+{
+    // common data types
+public:
+    /** 分节不存在时，sect_index() 的返回值 */
+    static const size_t npos = static_cast< size_t >(-1);
+
+protected:
+    typedef unsigned int       xu32_t;
+    typedef unsigned long long xu64_t;
+
+    /**
+     * @struct xsect_rec_t
+     * @brief  分节表 表项。
+     */
+    struct xsect_rec_t
+    {
+        xu32_t m_xu32_name;      ///< 分节名 在字符串池中的偏移量
+        xu32_t m_xu32_nlen;      ///< 分节名 长度
+        xu32_t m_xu32_kbeg;      ///< 首个键值 在 m_xvec_order 中的序号
+        xu32_t m_xu32_kcnt;      ///< 键值数量
+        xu32_t m_xu32_order;     ///< 分节在文件中的顺序（sect_name() 等接口使用的序号）
+    };
+
+    /**
+     * @struct xkey_rec_t
+     * @brief  键值表 表项（键值 紧随 键名 之后存放）。
+     */
+    struct xkey_rec_t
+    {
+        xu32_t m_xu32_sect;      ///< 所属分节 在分节表中的序号
+        xu32_t m_xu32_name;      ///< 键名 在字符串池中的偏移量
+        xu32_t m_xu32_nlen;      ///< 键名 长度
+    };
+
+    /**
+     * @struct xmphf_t
+     * @brief  最小完美哈希函数（哈希-位移）。
+     */
+    struct xmphf_t
+    {
+        xu64_t                m_xu64_seed;  ///< 哈希种子（构建失败时更换）
+        std::vector< xu32_t > m_xvec_disp;  ///< 各个分桶的 位移值
+
+        xmphf_t(void) : m_xu64_seed(0) { }
+
+        /**
+         * @brief 由哈希值计算槽位。
+         */
+        inline xu32_t slot(xu64_t xu64_hash, xu32_t xu32_size) const
+        {
+            xu32_t xu32_bucket = static_cast< xu32_t >(xu64_hash >> 32) %
+                                 static_cast< xu32_t >(m_xvec_disp.size());
+            return mix(static_cast< xu32_t >(xu64_hash) ^ m_xvec_disp[xu32_bucket]) % xu32_size;
+        }
+    };
+
+    // constructor/destructor
+public:
+    xini_frozen_t(void)
+    {
+
+    }
+
+    explicit xini_frozen_t(const xini_file_t & xini_file)
+    {
+        freeze(xini_file);
+    }
+
+    ~xini_frozen_t(void)
+    {
+
+    }
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 冻结配置对象：压缩存储 分节、键值，并构建最小完美哈希索引。
+     */
+    void freeze(const xini_file_t & xini_file)
+    {
+        clear();
+
+        //======================================
+        // 统计容量，一次性分配
+
+        size_t xst_nkey  = 0;
+        size_t xst_npool = 0;
+        for (xini_file_t::const_iterator
+                itsect  = xini_file.begin();
+                itsect != xini_file.end();
+                ++itsect)
+        {
+            xst_npool += (*itsect)->name().size() + 1;
+            for (xini_section_t::kv_const_iterator
+                    itkv  = (*itsect)->kv_begin();
+                    itkv != (*itsect)->kv_end();
+                    ++itkv)
+            {
+                xst_npool += (*itkv)->key().size() + (*itkv)->value().size() + 2;
+                ++xst_nkey;
+            }
+        }
+
+        m_xstr_pool.reserve(xst_npool);
+        m_xvec_sect.reserve(xini_file.sect_count());
+
+        std::vector< xkey_rec_t > xvec_key;
+        xvec_key.reserve(xst_nkey);
+
+        //======================================
+        // 分节表、字符串池（键值暂按文件顺序存放）
+
+        for (xini_file_t::const_iterator
+                itsect  = xini_file.begin();
+                itsect != xini_file.end();
+                ++itsect)
+        {
+            const xini_section_t * xsect_ptr = *itsect;
+
+            xsect_rec_t xsect;
+            xsect.m_xu32_name = pool_append(xsect_ptr->name());
+            xsect.m_xu32_nlen = static_cast< xu32_t >(xsect_ptr->name().size());
+            xsect.m_xu32_kbeg = static_cast< xu32_t >(xvec_key.size());
+            xsect.m_xu32_kcnt = static_cast< xu32_t >(xsect_ptr->kv_size());
+            xsect.m_xu32_order = static_cast< xu32_t >(m_xvec_sect.size());
+
+            for (xini_section_t::kv_const_iterator
+                    itkv  = xsect_ptr->kv_begin();
+                    itkv != xsect_ptr->kv_end();
+                    ++itkv)
+            {
+                xkey_rec_t xkey;
+                xkey.m_xu32_sect = static_cast< xu32_t >(m_xvec_sect.size());
+                xkey.m_xu32_name = pool_append((*itkv)->key());
+                xkey.m_xu32_nlen = static_cast< xu32_t >((*itkv)->key().size());
+                pool_append((*itkv)->value());
+                xvec_key.push_back(xkey);
+            }
+
+            m_xvec_sect.push_back(xsect);
+        }
+
+        //======================================
+        // 构建 分节名 的完美哈希，分节表按槽位重排
+
+        std::vector< xu32_t > xvec_slot;
+        for (;;)
+        {
+            std::vector< xu64_t > xvec_hash(m_xvec_sect.size());
+            for (size_t xst_iter = 0; xst_iter < m_xvec_sect.size(); ++xst_iter)
+            {
+                const char * xszt_name = &m_xstr_pool[m_xvec_sect[xst_iter].m_xu32_name];
+                xvec_hash[xst_iter] = hash_sect(m_xsect_mphf.m_xu64_seed,
+                                                xszt_name,
+                                                xszt_name + m_xvec_sect[xst_iter].m_xu32_nlen);
+            }
+
+            if (build_mphf(m_xsect_mphf, xvec_hash, xvec_slot))
+                break;
+            ++m_xsect_mphf.m_xu64_seed;
+        }
+
+        // 分节表 按槽位重排，键值记录的分节序号 随之修正
+        std::vector< xsect_rec_t > xvec_sect(m_xvec_sect.size());
+        for (size_t xst_iter = 0; xst_iter < m_xvec_sect.size(); ++xst_iter)
+        {
+            xvec_sect[xvec_slot[xst_iter]] = m_xvec_sect[xst_iter];
+            m_xvec_sorder.push_back(xvec_slot[xst_iter]);
+        }
+        m_xvec_sect.swap(xvec_sect);
+
+        for (size_t xst_iter = 0; xst_iter < xvec_key.size(); ++xst_iter)
+        {
+            xvec_key[xst_iter].m_xu32_sect = xvec_slot[xvec_key[xst_iter].m_xu32_sect];
+        }
+
+        //======================================
+        // 构建 分节名 + 键名 的完美哈希，键值表按槽位存放
+
+        for (;;)
+        {
+            std::vector< xu64_t > xvec_hash(xvec_key.size());
+            for (size_t xst_iter = 0; xst_iter < xvec_key.size(); ++xst_iter)
+            {
+                const xkey_rec_t  & xkey  = xvec_key[xst_iter];
+                const xsect_rec_t & xsect = m_xvec_sect[xkey.m_xu32_sect];
+                const char * xszt_sect = &m_xstr_pool[xsect.m_xu32_name];
+                const char * xszt_key  = &m_xstr_pool[xkey.m_xu32_name];
+
+                xvec_hash[xst_iter] = hash_key(m_xkey_mphf.m_xu64_seed,
+                                               xszt_sect, xszt_sect + xsect.m_xu32_nlen,
+                                               xszt_key , xszt_key  + xkey.m_xu32_nlen);
+            }
+
+            if (build_mphf(m_xkey_mphf, xvec_hash, xvec_slot))
+                break;
+            ++m_xkey_mphf.m_xu64_seed;
+        }
+
+        m_xvec_key.resize(xvec_key.size());
+        m_xvec_korder.resize(xvec_key.size());
+        for (size_t xst_iter = 0; xst_iter < xvec_key.size(); ++xst_iter)
+        {
+            m_xvec_key[xvec_slot[xst_iter]] = xvec_key[xst_iter];
+            m_xvec_korder[xst_iter] = xvec_slot[xst_iter];
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 清除所有内容。
+     */
+    void clear(void)
+    {
+        std::string().swap(m_xstr_pool);
+        std::vector< xsect_rec_t >().swap(m_xvec_sect);
+        std::vector< xkey_rec_t  >().swap(m_xvec_key);
+        std::vector< xu32_t >().swap(m_xvec_sorder);
+        std::vector< xu32_t >().swap(m_xvec_korder);
+        m_xsect_mphf = xmphf_t();
+        m_xkey_mphf  = xmphf_t();
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 分节数量。
+     */
+    inline size_t sect_count(void) const { return m_xvec_sect.size(); }
+
+    /**********************************************************/
+    /**
+     * @brief 键值数量。
+     */
+    inline size_t key_count(void) const { return m_xvec_key.size(); }
+
+    /**********************************************************/
+    /**
+     * @brief 占用的内存字节数（不含对象本身）。
+     */
+    size_t memory_size(void) const
+    {
+        return (m_xstr_pool.capacity() +
+                m_xvec_sect.capacity()   * sizeof(xsect_rec_t) +
+                m_xvec_key.capacity()    * sizeof(xkey_rec_t ) +
+                m_xvec_sorder.capacity() * sizeof(xu32_t) +
+                m_xvec_korder.capacity() * sizeof(xu32_t) +
+                m_xsect_mphf.m_xvec_disp.capacity() * sizeof(xu32_t) +
+                m_xkey_mphf.m_xvec_disp.capacity()  * sizeof(xu32_t));
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 查找分节的序号（忽略大小写，按分节在文件中出现的顺序，
+     *        可用于 sect_name()、sect_keys() 等接口），不存在时返回 npos 。
+     */
+    size_t sect_index(const std::string & xstr_sect) const
+    {
+        if (m_xvec_sect.empty())
+        {
+            return npos;
+        }
+
+        const char * xszt_sbeg = xstr_sect.c_str();
+        const char * xszt_send = xszt_sbeg + xstr_sect.size();
+        trim_range(xszt_sbeg, xszt_send, "[] \t\n\r\f\v");
+
+        xu32_t xu32_slot = m_xsect_mphf.slot(
+                                hash_sect(m_xsect_mphf.m_xu64_seed, xszt_sbeg, xszt_send),
+                                static_cast< xu32_t >(m_xvec_sect.size()));
+
+        const xsect_rec_t & xsect = m_xvec_sect[xu32_slot];
+        if (!same_name(xsect.m_xu32_name, xsect.m_xu32_nlen, xszt_sbeg, xszt_send))
+        {
+            return npos;
+        }
+
+        return xsect.m_xu32_order;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 查找键值（分节名、键名 均忽略大小写）。
+     * 
+     * @param [in ] xstr_sect : 分节名。
+     * @param [in ] xstr_key  : 键名。
+     * @param [out] xst_vlen  : 可为 NULL，返回键值长度。
+     * 
+     * @return const char * : 以 '\0' 结尾的键值；不存在时返回 NULL 。
+     */
+    const char * find(const std::string & xstr_sect,
+                      const std::string & xstr_key,
+                      size_t * xst_vlen = NULL) const
+    {
+        if (m_xvec_key.empty())
+        {
+            return NULL;
+        }
+
+        const char * xszt_sbeg = xstr_sect.c_str();
+        const char * xszt_send = xszt_sbeg + xstr_sect.size();
+        const char * xszt_kbeg = xstr_key.c_str();
+        const char * xszt_kend = xszt_kbeg + xstr_key.size();
+        trim_range(xszt_sbeg, xszt_send, "[] \t\n\r\f\v");
+        trim_range(xszt_kbeg, xszt_kend, XCHARS_TRIM);
+
+        const xkey_rec_t & xkey = m_xvec_key[
+                m_xkey_mphf.slot(hash_key(m_xkey_mphf.m_xu64_seed,
+                                          xszt_sbeg, xszt_send,
+                                          xszt_kbeg, xszt_kend),
+                                 static_cast< xu32_t >(m_xvec_key.size()))];
+
+        const xsect_rec_t & xsect = m_xvec_sect[xkey.m_xu32_sect];
+        if (!same_name(xkey.m_xu32_name, xkey.m_xu32_nlen, xszt_kbeg, xszt_kend) ||
+            !same_name(xsect.m_xu32_name, xsect.m_xu32_nlen, xszt_sbeg, xszt_send))
+        {
+            return NULL;
+        }
+
+        const char * xszt_value = &m_xstr_pool[xkey.m_xu32_name + xkey.m_xu32_nlen + 1];
+        if (NULL != xst_vlen)
+            *xst_vlen = strlen(xszt_value);
+        return xszt_value;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 读取键值，不存在时返回默认值。
+     */
+    inline const char * value(const std::string & xstr_sect,
+                              const std::string & xstr_key,
+                              const char * xszt_default = "") const
+    {
+        const char * xszt_value = find(xstr_sect, xstr_key);
+        return (NULL != xszt_value) ? xszt_value : xszt_default;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 第 xst_sect 个分节（按分节在文件中出现的顺序）的名称。
+     */
+    inline const char * sect_name(size_t xst_sect) const
+    {
+        return &m_xstr_pool[sect_rec(xst_sect).m_xu32_name];
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 第 xst_sect 个分节的键值数量。
+     */
+    inline size_t sect_keys(size_t xst_sect) const
+    {
+        return sect_rec(xst_sect).m_xu32_kcnt;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 第 xst_sect 个分节中，第 xst_key 个键值的键名。
+     */
+    inline const char * key_name(size_t xst_sect, size_t xst_key) const
+    {
+        return &m_xstr_pool[key_rec(xst_sect, xst_key).m_xu32_name];
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 第 xst_sect 个分节中，第 xst_key 个键值的键值。
+     */
+    inline const char * key_value(size_t xst_sect, size_t xst_key) const
+    {
+        const xkey_rec_t & xkey = key_rec(xst_sect, xst_key);
+        return &m_xstr_pool[xkey.m_xu32_name + xkey.m_xu32_nlen + 1];
+    }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief ASCII 字符转小写（与 xstr_icmp() 一致）。
+     */
+    static inline char fold(char xchar)
+    {
+        return ((xchar >= 'A') && (xchar <= 'Z')) ? static_cast< char >(xchar + ('a' - 'A')) : xchar;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 整数混合函数（MurmurHash3 的 fmix32）。
+     */
+    static inline xu32_t mix(xu32_t xu32_value)
+    {
+        xu32_value ^= xu32_value >> 16;
+        xu32_value *= 0x85EBCA6BU;
+        xu32_value ^= xu32_value >> 13;
+        xu32_value *= 0xC2B2AE35U;
+        xu32_value ^= xu32_value >> 16;
+        return xu32_value;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 向（转为小写后的）字符串计算 FNV-1a（64 位）哈希值。
+     */
+    static inline xu64_t hash_append(xu64_t xu64_hash, const char * xszt_beg, const char * xszt_end)
+    {
+        for (; xszt_beg != xszt_end; ++xszt_beg)
+        {
+            xu64_hash ^= static_cast< unsigned char >(fold(*xszt_beg));
+            xu64_hash *= 1099511628211ULL;
+        }
+
+        return xu64_hash;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 分节名 的哈希值。
+     */
+    static inline xu64_t hash_sect(xu64_t xu64_seed, const char * xszt_beg, const char * xszt_end)
+    {
+        return hash_append(14695981039346656037ULL ^ (xu64_seed * 0x9E3779B97F4A7C15ULL),
+                           xszt_beg, xszt_end);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 分节名 + 键名 的哈希值。
+     */
+    static inline xu64_t hash_key(xu64_t xu64_seed,
+                                  const char * xszt_sbeg, const char * xszt_send,
+                                  const char * xszt_kbeg, const char * xszt_kend)
+    {
+        xu64_t xu64_hash = hash_sect(xu64_seed, xszt_sbeg, xszt_send);
+        xu64_hash = (xu64_hash ^ '\n') * 1099511628211ULL;
+        return hash_append(xu64_hash, xszt_kbeg, xszt_kend);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 修剪 [xszt_beg, xszt_end) 区间前后端的字符集（不分配内存）。
+     */
+    static void trim_range(const char *& xszt_beg, const char *& xszt_end, const char * xchars)
+    {
+        while ((xszt_beg != xszt_end) && (NULL != strchr(xchars, *xszt_beg)))
+            ++xszt_beg;
+        while ((xszt_beg != xszt_end) && (NULL != strchr(xchars, *(xszt_end - 1))))
+            --xszt_end;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 构建最小完美哈希：各个分桶按键的数量 降序 依次寻找位移值，
+     *        使分桶中的键 都落在尚未占用的槽位上。
+     * 
+     * @param [out] xmphf     : 完美哈希函数（使用其中的哈希种子）。
+     * @param [in ] xvec_hash : 各个键的哈希值。
+     * @param [out] xvec_slot : 各个键的槽位。
+     * 
+     * @return bool : 某个分桶找不到可用的位移值时，返回 false（须更换哈希种子重试）。
+     */
+    static bool build_mphf(xmphf_t & xmphf,
+                           const std::vector< xu64_t > & xvec_hash,
+                           std::vector< xu32_t > & xvec_slot)
+    {
+        const xu32_t xu32_size   = static_cast< xu32_t >(xvec_hash.size());
+        const xu32_t xu32_bucket = xu32_size / 4 + 1;
+
+        xmphf.m_xvec_disp.assign(xu32_bucket, 0);
+        xvec_slot.assign(xu32_size, 0);
+
+        // 各个分桶中的键
+        std::vector< std::vector< xu32_t > > xvec_bucket(xu32_bucket);
+        for (xu32_t xu32_iter = 0; xu32_iter < xu32_size; ++xu32_iter)
+        {
+            xvec_bucket[static_cast< xu32_t >(xvec_hash[xu32_iter] >> 32) % xu32_bucket].push_back(xu32_iter);
+        }
+
+        // 分桶 按键的数量 降序排列
+        std::vector< std::pair< xu32_t, xu32_t > > xvec_order;
+        xvec_order.reserve(xu32_bucket);
+        for (xu32_t xu32_iter = 0; xu32_iter < xu32_bucket; ++xu32_iter)
+        {
+            if (!xvec_bucket[xu32_iter].empty())
+            {
+                xvec_order.push_back(std::make_pair(
+                    ~static_cast< xu32_t >(xvec_bucket[xu32_iter].size()), xu32_iter));
+            }
+        }
+        std::sort(xvec_order.begin(), xvec_order.end());
+
+        std::vector< bool > xvec_taken(xu32_size, false);
+        std::vector< xu32_t > xvec_try;
+
+        for (size_t xst_iter = 0; xst_iter < xvec_order.size(); ++xst_iter)
+        {
+            const xu32_t xu32_index = xvec_order[xst_iter].second;
+            const std::vector< xu32_t > & xvec_keys = xvec_bucket[xu32_index];
+
+            bool xbt_found = false;
+            for (xu32_t xu32_disp = 1; (xu32_disp < 0x00100000U) && !xbt_found; ++xu32_disp)
+            {
+                xvec_try.clear();
+                for (size_t xst_key = 0; xst_key < xvec_keys.size(); ++xst_key)
+                {
+                    xu32_t xu32_slot =
+                        mix(static_cast< xu32_t >(xvec_hash[xvec_keys[xst_key]]) ^ xu32_disp) % xu32_size;
+                    if (xvec_taken[xu32_slot] ||
+                        (std::find(xvec_try.begin(), xvec_try.end(), xu32_slot) != xvec_try.end()))
+                    {
+                        break;
+                    }
+
+                    xvec_try.push_back(xu32_slot);
+                }
+
+                if (xvec_try.size() != xvec_keys.size())
+                {
+                    continue;
+                }
+
+                for (size_t xst_key = 0; xst_key < xvec_keys.size(); ++xst_key)
+                {
+                    xvec_taken[xvec_try[xst_key]] = true;
+                    xvec_slot[xvec_keys[xst_key]] = xvec_try[xst_key];
+                }
+
+                xmphf.m_xvec_disp[xu32_index] = xu32_disp;
+                xbt_found = true;
+            }
+
+            if (!xbt_found)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 将字符串加入字符串池（以 '\0' 结尾），返回其偏移量。
+     */
+    xu32_t pool_append(const std::string & xstr)
+    {
+        xu32_t xu32_offset = static_cast< xu32_t >(m_xstr_pool.size());
+        m_xstr_pool.append(xstr).append(1, '\0');
+        return xu32_offset;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 比对字符串池中的名称 与 [xszt_beg, xszt_end) 区间（忽略大小写）。
+     */
+    bool same_name(xu32_t xu32_name, xu32_t xu32_nlen, const char * xszt_beg, const char * xszt_end) const
+    {
+        if (static_cast< size_t >(xszt_end - xszt_beg) != xu32_nlen)
+        {
+            return false;
+        }
+
+        const char * xszt_name = &m_xstr_pool[xu32_name];
+        for (; xszt_beg != xszt_end; ++xszt_beg, ++xszt_name)
+        {
+            if (fold(*xszt_beg) != fold(*xszt_name))
+                return false;
+        }
+
+        return true;
+    }
+
+    inline const xsect_rec_t & sect_rec(size_t xst_sect) const
+    {
+        return m_xvec_sect[m_xvec_sorder.at(xst_sect)];
+    }
+
+    inline const xkey_rec_t & key_rec(size_t xst_sect, size_t xst_key) const
+    {
+        const xsect_rec_t & xsect = sect_rec(xst_sect);
+        assert(xst_key < xsect.m_xu32_kcnt);
+        return m_xvec_key[m_xvec_korder[xsect.m_xu32_kbeg + xst_key]];
+    }
+
+    // data members
+protected:
+    std::string                m_xstr_pool;    ///< 字符串池
+    std::vector< xsect_rec_t > m_xvec_sect;    ///< 分节表（按槽位存放）
+    std::vector< xkey_rec_t  > m_xvec_key;     ///< 键值表（按槽位存放）
+    std::vector< xu32_t >      m_xvec_sorder;  ///< 文件顺序 -> 分节表 槽位
+    std::vector< xu32_t >      m_xvec_korder;  ///< 文件顺序 -> 键值表 槽位（同一分节的键值连续）
+    xmphf_t                    m_xsect_mphf;   ///< 分节名 的完美哈希函数
+    xmphf_t                    m_xkey_mphf;    ///< 分节名 + 键名 的完美哈希函数
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XINI_FROZEN_H__
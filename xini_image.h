@@ -0,0 +1,1024 @@
+﻿/**
+ * The MIT License (MIT)
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file xini_image.h
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * @author  ：Gaaagaa
+ * @date    : 2026-10-19
+ * @version : 1.0.0.0
+ * @brief   : INI 文件解析结果的 二进制缓存映像（可直接内存映射，无需逐节点分配内存）。
+ */
+
+#ifndef __XINI_IMAGE_H__
+#define __XINI_IMAGE_H__
+
+#include "xini_file.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <share.h>
+#include <process.h>
+#else // !_WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif // _WIN32
+
+////////////////////////////////////////////////////////////////////////////////
+// xini_image_t
+
+/**
+ * @class xini_image_t
+ * @brief INI 文件的二进制缓存映像（只读）。
+ *
+ * <pre>
+ * 映像文件保存在 INI 文件旁（路径为 INI 文件路径 + ".xbin"），其内容依次为：
+ *  文件头   ：标识、版本、映像大小，以及 源文件 的 大小、修改时间、内容校验值（FNV-1a）；
+ *  分节表   ：各个分节的 名称 与 键值区间（键值表中同一分节的键值连续存放）；
+ *  键值表   ：各个键值的 所属分节、键名、键值；
+ *  哈希索引 ：分节名、（分节名, 键名）的 开放寻址 哈希表（忽略大小写），存放的是表项序号；
+ *  字符串池 ：以 '\0' 结尾的 分节名、键名、键值。
+ * 映像内部只使用相对于映像起始位置的偏移量，可直接映射到任意地址使用，
+ * 打开映像时 映射文件 并校验文件头 与 各个表项（偏移量、序号 均须在范围内），
+ * 之后 查找键值 不再做边界检查，返回的字符串直接指向映像内存。
+ * 
+ * 源文件 的 大小、修改时间、内容校验值 与文件头中记录的不一致时，映像失效，
+ * open() 会重新解析源文件并重写映像（先写入临时文件，再以重命名替换，
+ * 多个进程同时重建时，不会读到写了一半的映像）。
+ * 注意：映像只记录源文件本身的状态，其所包含（@include）的文件的变化，不会使映像失效。
+ * 
+ * 映像为本机字节序，不可在不同字节序的平台之间共享。
+ *
+ * 使用示例：
+ *  xini_image_t ximage;
+ *  if (ximage.open("/etc/app/app.ini"))
+ *  {
+ *      const char * xszt_host = ximage.find("db", "host");
+ *  }
+ * </pre>
+ */
+class xini_image_t
+{
+    // common data types
+public:
+    /** 分节不存在时，sect_index() 的返回值 */
+    static const size_t npos = static_cast< size_t >(-1);
+
+protected:
+    typedef unsigned int       xu32_t;
+    typedef unsigned long long xu64_t;
+
+    enum xconstant_t
+    {
+        XIMAGE_VERSION = 1,           ///< 映像格式版本
+        XIMAGE_BORDER  = 0x01020304,  ///< 字节序标识
+        XIMAGE_EMPTY   = 0            ///< 哈希表中的空槽位（槽位中存放 表项序号 + 1）
+    };
+
+    /**
+     * @struct xhead_t
+     * @brief  映像文件头。
+     */
+    struct xhead_t
+    {
+        char   m_xszt_magic[8];  ///< 标识 "XINIBIN"
+        xu32_t m_xu32_version;   ///< 映像格式版本
+        xu32_t m_xu32_border;    ///< 字节序标识
+        xu64_t m_xu64_isize;     ///< 映像大小
+        xu64_t m_xu64_fsize;     ///< 源文件 大小
+        xu64_t m_xu64_mtime;     ///< 源文件 修改时间
+        xu64_t m_xu64_fhash;     ///< 源文件 内容校验值
+        xu32_t m_xu32_nsect;     ///< 分节表 表项数量
+        xu32_t m_xu32_osect;     ///< 分节表 偏移量
+        xu32_t m_xu32_nkey;      ///< 键值表 表项数量
+        xu32_t m_xu32_okey;      ///< 键值表 偏移量
+        xu32_t m_xu32_nshash;    ///< 分节名 哈希表 槽位数量（2 的幂）
+        xu32_t m_xu32_oshash;    ///< 分节名 哈希表 偏移量
+        xu32_t m_xu32_nkhash;    ///< 键名   哈希表 槽位数量（2 的幂）
+        xu32_t m_xu32_okhash;    ///< 键名   哈希表 偏移量
+        xu32_t m_xu32_npool;     ///< 字符串池 大小
+        xu32_t m_xu32_opool;     ///< 字符串池 偏移量
+    };
+
+    /**
+     * @struct xsect_rec_t
+     * @brief  分节表 表项。
+     */
+    struct xsect_rec_t
+    {
+        xu32_t m_xu32_name;      ///< 分节名 在字符串池中的偏移量
+        xu32_t m_xu32_nlen;      ///< 分节名 长度
+        xu32_t m_xu32_kbeg;      ///< 首个键值 在键值表中的序号
+        xu32_t m_xu32_kcnt;      ///< 键值数量
+    };
+
+    /**
+     * @struct xkey_rec_t
+     * @brief  键值表 表项。
+     */
+    struct xkey_rec_t
+    {
+        xu32_t m_xu32_sect;      ///< 所属分节 在分节表中的序号
+        xu32_t m_xu32_name;      ///< 键名 在字符串池中的偏移量
+        xu32_t m_xu32_nlen;      ///< 键名 长度
+        xu32_t m_xu32_value;     ///< 键值 在字符串池中的偏移量
+        xu32_t m_xu32_vlen;      ///< 键值 长度
+    };
+
+    /**
+     * @struct xfstat_t
+     * @brief  源文件的状态。
+     */
+    struct xfstat_t
+    {
+        xu64_t m_xu64_fsize;     ///< 文件大小
+        xu64_t m_xu64_mtime;     ///< 修改时间
+        xu64_t m_xu64_fhash;     ///< 内容校验值
+    };
+
+    // constructor/destructor
+public:
+    xini_image_t(void)
+        : m_ximage_ptr(NULL)
+        , m_xst_isize(0)
+    {
+
+    }
+
+    ~xini_image_t(void)
+    {
+        close();
+    }
+
+private:
+    // 禁用 拷贝构造 和 赋值 操作（映像内存由当前对象独占）
+    xini_image_t(const xini_image_t &);
+    xini_image_t & operator = (const xini_image_t &);
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 映像文件的路径（INI 文件路径 + ".xbin"）。
+     */
+    static inline std::string image_path(const std::string & xstr_filepath)
+    {
+        return (xstr_filepath + ".xbin");
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 打开 INI 文件的缓存映像，映像不存在 或 已失效 时，（可选）重新解析源文件并重写映像。
+     * 
+     * @param [in ] xstr_filepath : INI 文件路径。
+     * @param [in ] xbt_rebuild   : 映像无效时，是否重建映像。
+     * 
+     * @return bool
+     *         - 成功，返回 true ；
+     *         - 失败，返回 false（源文件不存在、映像无效且不重建、映像写入失败 等）。
+     */
+    bool open(const std::string & xstr_filepath, bool xbt_rebuild = true)
+    {
+        close();
+
+        //======================================
+        // 读取源文件的内容与状态（内容只用于计算校验值，与 解析 共用一次读取）
+
+        std::string xstr_text;
+        xfstat_t    xfstat;
+        if (!read_source(xstr_filepath, xstr_text, xfstat))
+        {
+            return false;
+        }
+
+        std::string xstr_image = image_path(xstr_filepath);
+        if (map_image(xstr_image) && check_image(xfstat))
+        {
+            return true;
+        }
+
+        close();
+        if (!xbt_rebuild)
+        {
+            return false;
+        }
+
+        //======================================
+        // 重新解析源文件，写入映像后再映射
+
+        xini_file_t xini_file;
+        std::istringstream istr(xstr_text);
+        xini_file.load(istr, xstr_filepath);
+        xini_file.set_dirty(false);
+
+        if (!write_image(xini_file, xfstat, xstr_image))
+        {
+            return false;
+        }
+
+        if (map_image(xstr_image) && check_image(xfstat))
+        {
+            return true;
+        }
+
+        close();
+        return false;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 将已解析的 xini_file_t 对象写为 源文件 的缓存映像。
+     * 
+     * @param [in ] xini_file     : 配置对象（应当与源文件的当前内容一致）。
+     * @param [in ] xstr_filepath : 源文件路径（映像写在其旁边）。
+     */
+    static bool write(const xini_file_t & xini_file, const std::string & xstr_filepath)
+    {
+        std::string xstr_text;
+        xfstat_t    xfstat;
+        if (!read_source(xstr_filepath, xstr_text, xfstat))
+        {
+            return false;
+        }
+
+        return write_image(xini_file, xfstat, image_path(xstr_filepath));
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 关闭映像。
+     */
+    void close(void)
+    {
+        if (NULL != m_ximage_ptr)
+        {
+#ifdef _WIN32
+            delete [] m_ximage_ptr;
+#else // !_WIN32
+            munmap(const_cast< char * >(m_ximage_ptr), m_xst_isize);
+#endif // _WIN32
+        }
+
+        m_ximage_ptr = NULL;
+        m_xst_isize  = 0;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 映像是否已打开。
+     */
+    inline bool is_open(void) const { return (NULL != m_ximage_ptr); }
+
+    /**********************************************************/
+    /**
+     * @brief 分节数量。
+     */
+    inline size_t sect_count(void) const
+    {
+        return is_open() ? head()->m_xu32_nsect : 0;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 键值数量。
+     */
+    inline size_t key_count(void) const
+    {
+        return is_open() ? head()->m_xu32_nkey : 0;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 查找分节的序号（忽略大小写），不存在时返回 npos 。
+     */
+    size_t sect_index(const std::string & xstr_sect) const
+    {
+        if (!is_open())
+        {
+            return npos;
+        }
+
+        const char * xszt_sbeg = xstr_sect.c_str();
+        const char * xszt_send = xszt_sbeg + xstr_sect.size();
+        trim_range(xszt_sbeg, xszt_send, "[] \t\n\r\f\v");
+
+        const xhead_t * xhead_ptr = head();
+        const xu32_t  * xslot_ptr = table< xu32_t >(xhead_ptr->m_xu32_oshash);
+        const xu32_t    xu32_mask = xhead_ptr->m_xu32_nshash - 1;
+
+        for (xu32_t xu32_iter = hash_name(0, xszt_sbeg, xszt_send) & xu32_mask;
+             XIMAGE_EMPTY != xslot_ptr[xu32_iter];
+             xu32_iter = (xu32_iter + 1) & xu32_mask)
+        {
+            const xsect_rec_t & xsect = table< xsect_rec_t >(xhead_ptr->m_xu32_osect)[xslot_ptr[xu32_iter] - 1];
+            if (same_name(xsect.m_xu32_name, xsect.m_xu32_nlen, xszt_sbeg, xszt_send))
+            {
+                return (xslot_ptr[xu32_iter] - 1);
+            }
+        }
+
+        return npos;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 查找键值（分节名、键名 均忽略大小写）。
+     * 
+     * @param [in ] xstr_sect : 分节名。
+     * @param [in ] xstr_key  : 键名。
+     * @param [out] xst_vlen  : 可为 NULL，返回键值长度。
+     * 
+     * @return const char * : 指向映像内存中 以 '\0' 结尾的键值；不存在时返回 NULL 。
+     */
+    const char * find(const std::string & xstr_sect,
+                      const std::string & xstr_key,
+                      size_t * xst_vlen = NULL) const
+    {
+        if (!is_open())
+        {
+            return NULL;
+        }
+
+        const char * xszt_sbeg = xstr_sect.c_str();
+        const char * xszt_send = xszt_sbeg + xstr_sect.size();
+        const char * xszt_kbeg = xstr_key.c_str();
+        const char * xszt_kend = xszt_kbeg + xstr_key.size();
+        trim_range(xszt_sbeg, xszt_send, "[] \t\n\r\f\v");
+        trim_range(xszt_kbeg, xszt_kend, XCHARS_TRIM);
+
+        xu32_t xu32_hash = hash_name(0, xszt_sbeg, xszt_send);
+        xu32_hash = hash_name(xu32_hash, "\n", "\n" + 1);
+        xu32_hash = hash_name(xu32_hash, xszt_kbeg, xszt_kend);
+
+        const xhead_t     * xhead_ptr = head();
+        const xu32_t      * xslot_ptr = table< xu32_t >(xhead_ptr->m_xu32_okhash);
+        const xsect_rec_t * xsect_ptr = table< xsect_rec_t >(xhead_ptr->m_xu32_osect);
+        const xkey_rec_t  * xkey_ptr  = table< xkey_rec_t >(xhead_ptr->m_xu32_okey);
+        const xu32_t        xu32_mask = xhead_ptr->m_xu32_nkhash - 1;
+
+        for (xu32_t xu32_iter = xu32_hash & xu32_mask;
+             XIMAGE_EMPTY != xslot_ptr[xu32_iter];
+             xu32_iter = (xu32_iter + 1) & xu32_mask)
+        {
+            const xkey_rec_t  & xkey  = xkey_ptr[xslot_ptr[xu32_iter] - 1];
+            const xsect_rec_t & xsect = xsect_ptr[xkey.m_xu32_sect];
+            if (same_name(xkey.m_xu32_name, xkey.m_xu32_nlen, xszt_kbeg, xszt_kend) &&
+                same_name(xsect.m_xu32_name, xsect.m_xu32_nlen, xszt_sbeg, xszt_send))
+            {
+                if (NULL != xst_vlen)
+                    *xst_vlen = xkey.m_xu32_vlen;
+                return pool(xkey.m_xu32_value);
+            }
+        }
+
+        return NULL;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 读取键值，不存在时返回默认值。
+     */
+    inline const char * value(const std::string & xstr_sect,
+                              const std::string & xstr_key,
+                              const char * xszt_default = "") const
+    {
+        const char * xszt_value = find(xstr_sect, xstr_key);
+        return (NULL != xszt_value) ? xszt_value : xszt_default;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 第 xst_sect 个分节的名称（按分节在文件中出现的顺序）。
+     */
+    inline const char * sect_name(size_t xst_sect) const
+    {
+        return pool(sect_rec(xst_sect).m_xu32_name);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 第 xst_sect 个分节的键值数量。
+     */
+    inline size_t sect_keys(size_t xst_sect) const
+    {
+        return sect_rec(xst_sect).m_xu32_kcnt;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 第 xst_sect 个分节中，第 xst_key 个键值的键名。
+     */
+    inline const char * key_name(size_t xst_sect, size_t xst_key) const
+    {
+        return pool(key_rec(xst_sect, xst_key).m_xu32_name);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 第 xst_sect 个分节中，第 xst_key 个键值的键值。
+     */
+    inline const char * key_value(size_t xst_sect, size_t xst_key) const
+    {
+        return pool(key_rec(xst_sect, xst_key).m_xu32_value);
+    }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief ASCII 字符转小写（与 xstr_icmp() 一致）。
+     */
+    static inline char fold(char xchar)
+    {
+        return ((xchar >= 'A') && (xchar <= 'Z')) ? static_cast< char >(xchar + ('a' - 'A')) : xchar;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 计算（转为小写后的）字符串的 FNV-1a 哈希值。
+     */
+    static inline xu32_t hash_name(xu32_t xu32_hash, const char * xszt_beg, const char * xszt_end)
+    {
+        if (0 == xu32_hash)
+            xu32_hash = 2166136261U;
+
+        for (; xszt_beg != xszt_end; ++xszt_beg)
+        {
+            xu32_hash ^= static_cast< unsigned char >(fold(*xszt_beg));
+            xu32_hash *= 16777619U;
+        }
+
+        return xu32_hash;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 计算源文件内容的 FNV-1a（64 位）校验值。
+     */
+    static xu64_t hash_text(const std::string & xstr_text)
+    {
+        xu64_t xu64_hash = 14695981039346656037ULL;
+        for (std::string::size_type xst_iter = 0; xst_iter < xstr_text.size(); ++xst_iter)
+        {
+            xu64_hash ^= static_cast< unsigned char >(xstr_text[xst_iter]);
+            xu64_hash *= 1099511628211ULL;
+        }
+
+        return xu64_hash;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 修剪 [xszt_beg, xszt_end) 区间前后端的字符集（不分配内存）。
+     */
+    static void trim_range(const char *& xszt_beg, const char *& xszt_end, const char * xchars)
+    {
+        while ((xszt_beg != xszt_end) && (NULL != strchr(xchars, *xszt_beg)))
+            ++xszt_beg;
+        while ((xszt_beg != xszt_end) && (NULL != strchr(xchars, *(xszt_end - 1))))
+            --xszt_end;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 读取源文件的内容与状态。
+     */
+    static bool read_source(const std::string & xstr_filepath,
+                            std::string & xstr_text,
+                            xfstat_t & xfstat)
+    {
+        struct stat xstat;
+        if (0 != stat(xstr_filepath.c_str(), &xstat))
+        {
+            return false;
+        }
+
+        std::ifstream xfile_reader(xstr_filepath.c_str(), std::ios_base::binary);
+        if (!xfile_reader.is_open())
+        {
+            return false;
+        }
+
+        xstr_text.resize(static_cast< size_t >(xstat.st_size));
+        if (!xstr_text.empty())
+        {
+            xfile_reader.read(&xstr_text[0], static_cast< std::streamsize >(xstr_text.size()));
+            xstr_text.resize(static_cast< size_t >(xfile_reader.gcount()));
+        }
+
+        xfstat.m_xu64_fsize = static_cast< xu64_t >(xstat.st_size);
+        xfstat.m_xu64_mtime = static_cast< xu64_t >(xstat.st_mtime);
+        xfstat.m_xu64_fhash = hash_text(xstr_text);
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 大于等于 xu32_size 的最小的 2 的幂（至少为 2）。
+     */
+    static xu32_t pow2_size(xu32_t xu32_size)
+    {
+        xu32_t xu32_pow2 = 2;
+        while (xu32_pow2 < xu32_size)
+            xu32_pow2 <<= 1;
+        return xu32_pow2;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 向哈希表中加入表项序号（开放寻址，线性探测）。
+     */
+    static void hash_insert(std::vector< xu32_t > & xvec_slot, xu32_t xu32_hash, xu32_t xu32_index)
+    {
+        xu32_t xu32_mask = static_cast< xu32_t >(xvec_slot.size()) - 1;
+        xu32_t xu32_iter = xu32_hash & xu32_mask;
+        while (XIMAGE_EMPTY != xvec_slot[xu32_iter])
+            xu32_iter = (xu32_iter + 1) & xu32_mask;
+        xvec_slot[xu32_iter] = xu32_index + 1;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 将字符串加入字符串池（以 '\0' 结尾），返回其偏移量。
+     */
+    static xu32_t pool_append(std::string & xstr_pool, const std::string & xstr)
+    {
+        xu32_t xu32_offset = static_cast< xu32_t >(xstr_pool.size());
+        xstr_pool.append(xstr).append(1, '\0');
+        return xu32_offset;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 按 8 字节对齐，向映像中追加数据块，返回其偏移量。
+     */
+    static xu32_t image_append(std::string & xstr_image, const void * xblock_ptr, size_t xst_size)
+    {
+        xstr_image.resize((xstr_image.size() + 7) & ~static_cast< std::string::size_type >(7), '\0');
+        xu32_t xu32_offset = static_cast< xu32_t >(xstr_image.size());
+        if (xst_size > 0)
+            xstr_image.append(static_cast< const char * >(xblock_ptr), xst_size);
+        return xu32_offset;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 构建映像，写入临时文件后 重命名 为映像文件。
+     */
+    static bool write_image(const xini_file_t & xini_file,
+                            const xfstat_t & xfstat,
+                            const std::string & xstr_image)
+    {
+        std::vector< xsect_rec_t > xvec_sect;
+        std::vector< xkey_rec_t  > xvec_key;
+        std::string                xstr_pool;
+
+        std::vector< xu32_t > xvec_shash(pow2_size(static_cast< xu32_t >(xini_file.sect_count()) * 2), XIMAGE_EMPTY);
+        std::vector< xu32_t > xvec_khash;
+        std::vector< xu32_t > xvec_kname;  // 各个键值的 哈希值
+
+        //======================================
+        // 分节表、键值表、字符串池
+
+        for (xini_file_t::const_iterator
+                itsect  = xini_file.begin();
+                itsect != xini_file.end();
+                ++itsect)
+        {
+            const xini_section_t * xsect_ptr = *itsect;
+            const std::string    & xstr_name = xsect_ptr->name();
+
+            xsect_rec_t xsect;
+            xsect.m_xu32_name = pool_append(xstr_pool, xstr_name);
+            xsect.m_xu32_nlen = static_cast< xu32_t >(xstr_name.size());
+            xsect.m_xu32_kbeg = static_cast< xu32_t >(xvec_key.size());
+            xsect.m_xu32_kcnt = static_cast< xu32_t >(xsect_ptr->kv_size());
+
+            xu32_t xu32_shash = hash_name(0, xstr_name.data(), xstr_name.data() + xstr_name.size());
+            hash_insert(xvec_shash, xu32_shash, static_cast< xu32_t >(xvec_sect.size()));
+            xu32_shash = hash_name(xu32_shash, "\n", "\n" + 1);
+
+            for (xini_section_t::kv_const_iterator
+                    itkv  = xsect_ptr->kv_begin();
+                    itkv != xsect_ptr->kv_end();
+                    ++itkv)
+            {
+                const std::string & xstr_key   = (*itkv)->key();
+                const std::string & xstr_value = (*itkv)->value();
+
+                xkey_rec_t xkey;
+                xkey.m_xu32_sect  = static_cast< xu32_t >(xvec_sect.size());
+                xkey.m_xu32_name  = pool_append(xstr_pool, xstr_key);
+                xkey.m_xu32_nlen  = static_cast< xu32_t >(xstr_key.size());
+                xkey.m_xu32_value = pool_append(xstr_pool, xstr_value);
+                xkey.m_xu32_vlen  = static_cast< xu32_t >(xstr_value.size());
+                xvec_key.push_back(xkey);
+
+                xvec_kname.push_back(hash_name(xu32_shash, xstr_key.data(), xstr_key.data() + xstr_key.size()));
+            }
+
+            xvec_sect.push_back(xsect);
+        }
+
+        xvec_khash.resize(pow2_size(static_cast< xu32_t >(xvec_key.size()) * 2), XIMAGE_EMPTY);
+        for (xu32_t xu32_iter = 0; xu32_iter < static_cast< xu32_t >(xvec_kname.size()); ++xu32_iter)
+        {
+            hash_insert(xvec_khash, xvec_kname[xu32_iter], xu32_iter);
+        }
+
+        //======================================
+        // 组装映像
+
+        xhead_t xhead;
+        memset(&xhead, 0, sizeof(xhead_t));
+        memcpy(xhead.m_xszt_magic, "XINIBIN", 8);
+        xhead.m_xu32_version = XIMAGE_VERSION;
+        xhead.m_xu32_border  = XIMAGE_BORDER;
+        xhead.m_xu64_fsize   = xfstat.m_xu64_fsize;
+        xhead.m_xu64_mtime   = xfstat.m_xu64_mtime;
+        xhead.m_xu64_fhash   = xfstat.m_xu64_fhash;
+        xhead.m_xu32_nsect   = static_cast< xu32_t >(xvec_sect.size());
+        xhead.m_xu32_nkey    = static_cast< xu32_t >(xvec_key.size());
+        xhead.m_xu32_nshash  = static_cast< xu32_t >(xvec_shash.size());
+        xhead.m_xu32_nkhash  = static_cast< xu32_t >(xvec_khash.size());
+        xhead.m_xu32_npool   = static_cast< xu32_t >(xstr_pool.size());
+
+        std::string xstr_data(sizeof(xhead_t), '\0');
+        xstr_data.reserve(sizeof(xhead_t) + 40 +
+                          xvec_sect.size()  * sizeof(xsect_rec_t) +
+                          xvec_key.size()   * sizeof(xkey_rec_t ) +
+                          xvec_shash.size() * sizeof(xu32_t) +
+                          xvec_khash.size() * sizeof(xu32_t) +
+                          xstr_pool.size());
+
+        xhead.m_xu32_osect  = image_append(xstr_data, xvec_sect.empty() ? NULL : &xvec_sect[0], xvec_sect.size() * sizeof(xsect_rec_t));
+        xhead.m_xu32_okey   = image_append(xstr_data, xvec_key.empty()  ? NULL : &xvec_key[0] , xvec_key.size()  * sizeof(xkey_rec_t ));
+        xhead.m_xu32_oshash = image_append(xstr_data, &xvec_shash[0], xvec_shash.size() * sizeof(xu32_t));
+        xhead.m_xu32_okhash = image_append(xstr_data, &xvec_khash[0], xvec_khash.size() * sizeof(xu32_t));
+        xhead.m_xu32_opool  = image_append(xstr_data, xstr_pool.data(), xstr_pool.size());
+        xhead.m_xu64_isize  = xstr_data.size();
+        memcpy(&xstr_data[0], &xhead, sizeof(xhead_t));
+
+        //======================================
+        // 先写入临时文件，再重命名（替换旧的映像）
+
+        std::string xstr_temp;
+        FILE * xfile_ptr = create_temp(xstr_image, xstr_temp);
+        if (NULL == xfile_ptr)
+        {
+            return false;
+        }
+
+        bool xbt_write = (xstr_data.size() == fwrite(xstr_data.data(), 1, xstr_data.size(), xfile_ptr));
+        if ((0 != fclose(xfile_ptr)) || !xbt_write)
+        {
+            remove(xstr_temp.c_str());
+            return false;
+        }
+
+#ifdef _WIN32
+        remove(xstr_image.c_str());
+#endif // _WIN32
+        if (0 != rename(xstr_temp.c_str(), xstr_image.c_str()))
+        {
+            remove(xstr_temp.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 独占创建 写入映像用的临时文件（文件名在 进程、线程 之间均不会冲突）。
+     * 
+     * @param [in ] xstr_image : 映像文件路径（临时文件与其位于同一目录，以便重命名）。
+     * @param [out] xstr_temp  : 返回临时文件路径。
+     * 
+     * @return FILE * : 以二进制写方式打开的临时文件，失败时返回 NULL 。
+     */
+    static FILE * create_temp(const std::string & xstr_image, std::string & xstr_temp)
+    {
+#ifdef _WIN32
+        // 以 _O_EXCL 方式创建，文件已存在（其他线程/进程正在写）时，换下一个序号
+        for (unsigned int xut_iter = 0; xut_iter < 1024; ++xut_iter)
+        {
+            std::ostringstream ostr;
+            ostr << xstr_image << '.' << _getpid() << '.' << xut_iter << ".tmp";
+            xstr_temp = ostr.str();
+
+            int xfd = -1;
+            if (0 == _sopen_s(&xfd, xstr_temp.c_str(),
+                              _O_CREAT | _O_EXCL | _O_WRONLY | _O_BINARY,
+                              _SH_DENYNO, _S_IREAD | _S_IWRITE))
+            {
+                FILE * xfile_ptr = _fdopen(xfd, "wb");
+                if (NULL == xfile_ptr)
+                {
+                    _close(xfd);
+                    remove(xstr_temp.c_str());
+                }
+
+                return xfile_ptr;
+            }
+
+            if (EEXIST != errno)
+            {
+                break;
+            }
+        }
+
+        return NULL;
+#else // !_WIN32
+        xstr_temp = xstr_image + ".XXXXXX";
+        int xfd = mkstemp(&xstr_temp[0]);
+        if (-1 == xfd)
+        {
+            return NULL;
+        }
+
+        // mkstemp() 创建的文件只有属主可读写，映像须可由其他进程读取
+        FILE * xfile_ptr = (0 == fchmod(xfd, 0644)) ? fdopen(xfd, "wb") : NULL;
+        if (NULL == xfile_ptr)
+        {
+            ::close(xfd);
+            remove(xstr_temp.c_str());
+        }
+
+        return xfile_ptr;
+#endif // _WIN32
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 映射映像文件（非 POSIX 平台，一次性读入内存）。
+     */
+    bool map_image(const std::string & xstr_image)
+    {
+        close();
+
+#ifdef _WIN32
+        std::ifstream xfile_reader(xstr_image.c_str(), std::ios_base::binary);
+        if (!xfile_reader.is_open())
+        {
+            return false;
+        }
+
+        xfile_reader.seekg(0, std::ios_base::end);
+        std::streamoff xst_size = xfile_reader.tellg();
+        xfile_reader.seekg(0, std::ios_base::beg);
+        if (xst_size < static_cast< std::streamoff >(sizeof(xhead_t)))
+        {
+            return false;
+        }
+
+        char * xbuffer_ptr = new char[static_cast< size_t >(xst_size)];
+        if (!xfile_reader.read(xbuffer_ptr, static_cast< std::streamsize >(xst_size)))
+        {
+            delete [] xbuffer_ptr;
+            return false;
+        }
+
+        m_ximage_ptr = xbuffer_ptr;
+        m_xst_isize  = static_cast< size_t >(xst_size);
+#else // !_WIN32
+        int xfd = ::open(xstr_image.c_str(), O_RDONLY);
+        if (-1 == xfd)
+        {
+            return false;
+        }
+
+        struct stat xstat;
+        if ((0 != fstat(xfd, &xstat)) ||
+            (xstat.st_size < static_cast< off_t >(sizeof(xhead_t))))
+        {
+            ::close(xfd);
+            return false;
+        }
+
+        void * xmmap_ptr = mmap(NULL, static_cast< size_t >(xstat.st_size), PROT_READ, MAP_SHARED, xfd, 0);
+        ::close(xfd);
+        if (MAP_FAILED == xmmap_ptr)
+        {
+            return false;
+        }
+
+        m_ximage_ptr = static_cast< const char * >(xmmap_ptr);
+        m_xst_isize  = static_cast< size_t >(xstat.st_size);
+#endif // _WIN32
+
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 校验映像：文件头、各数据块的范围、各个表项，以及 源文件 的状态。
+     */
+    bool check_image(const xfstat_t & xfstat) const
+    {
+        const xhead_t * xhead_ptr = head();
+
+        if ((0 != memcmp(xhead_ptr->m_xszt_magic, "XINIBIN", 8)) ||
+            (XIMAGE_VERSION != xhead_ptr->m_xu32_version) ||
+            (XIMAGE_BORDER  != xhead_ptr->m_xu32_border ) ||
+            (m_xst_isize    != xhead_ptr->m_xu64_isize  ))
+        {
+            return false;
+        }
+
+        if ((xfstat.m_xu64_fsize != xhead_ptr->m_xu64_fsize) ||
+            (xfstat.m_xu64_mtime != xhead_ptr->m_xu64_mtime) ||
+            (xfstat.m_xu64_fhash != xhead_ptr->m_xu64_fhash))
+        {
+            return false;
+        }
+
+        // 哈希表槽位数量须为 2 的幂，且有空槽位（保证查找可以结束）
+        if ((xhead_ptr->m_xu32_nshash <= xhead_ptr->m_xu32_nsect) ||
+            (xhead_ptr->m_xu32_nkhash <= xhead_ptr->m_xu32_nkey ) ||
+            (0 != (xhead_ptr->m_xu32_nshash & (xhead_ptr->m_xu32_nshash - 1))) ||
+            (0 != (xhead_ptr->m_xu32_nkhash & (xhead_ptr->m_xu32_nkhash - 1))))
+        {
+            return false;
+        }
+
+        if (!check_block(xhead_ptr->m_xu32_osect , xhead_ptr->m_xu32_nsect  * static_cast< xu64_t >(sizeof(xsect_rec_t))) ||
+            !check_block(xhead_ptr->m_xu32_okey  , xhead_ptr->m_xu32_nkey   * static_cast< xu64_t >(sizeof(xkey_rec_t ))) ||
+            !check_block(xhead_ptr->m_xu32_oshash, xhead_ptr->m_xu32_nshash * static_cast< xu64_t >(sizeof(xu32_t))) ||
+            !check_block(xhead_ptr->m_xu32_okhash, xhead_ptr->m_xu32_nkhash * static_cast< xu64_t >(sizeof(xu32_t))) ||
+            !check_block(xhead_ptr->m_xu32_opool , xhead_ptr->m_xu32_npool))
+        {
+            return false;
+        }
+
+        return check_records() &&
+               check_slots(xhead_ptr->m_xu32_oshash, xhead_ptr->m_xu32_nshash, xhead_ptr->m_xu32_nsect) &&
+               check_slots(xhead_ptr->m_xu32_okhash, xhead_ptr->m_xu32_nkhash, xhead_ptr->m_xu32_nkey );
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 校验 分节表 与 键值表：各分节的键值区间 依次相连且覆盖整个键值表，
+     *        各键值的所属分节 与 区间一致，名称、键值 均位于字符串池内且以 '\0' 结尾。
+     */
+    bool check_records(void) const
+    {
+        const xhead_t     * xhead_ptr = head();
+        const xsect_rec_t * xsect_ptr = table< xsect_rec_t >(xhead_ptr->m_xu32_osect);
+        const xkey_rec_t  * xkey_ptr  = table< xkey_rec_t >(xhead_ptr->m_xu32_okey);
+
+        xu64_t xu64_kbeg = 0;
+        for (xu32_t xu32_sect = 0; xu32_sect < xhead_ptr->m_xu32_nsect; ++xu32_sect)
+        {
+            const xsect_rec_t & xsect = xsect_ptr[xu32_sect];
+            if ((xsect.m_xu32_kbeg != xu64_kbeg) ||
+                ((xu64_kbeg + xsect.m_xu32_kcnt) > xhead_ptr->m_xu32_nkey) ||
+                !check_name(xsect.m_xu32_name, xsect.m_xu32_nlen))
+            {
+                return false;
+            }
+
+            for (xu32_t xu32_iter = 0; xu32_iter < xsect.m_xu32_kcnt; ++xu32_iter)
+            {
+                const xkey_rec_t & xkey = xkey_ptr[xsect.m_xu32_kbeg + xu32_iter];
+                if ((xkey.m_xu32_sect != xu32_sect) ||
+                    !check_name(xkey.m_xu32_name , xkey.m_xu32_nlen) ||
+                    !check_name(xkey.m_xu32_value, xkey.m_xu32_vlen))
+                {
+                    return false;
+                }
+            }
+
+            xu64_kbeg += xsect.m_xu32_kcnt;
+        }
+
+        return (xu64_kbeg == xhead_ptr->m_xu32_nkey);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 校验哈希表：槽位中的表项序号不超过表项数量，且至少有一个空槽位（保证查找可以结束）。
+     */
+    bool check_slots(xu32_t xu32_offset, xu32_t xu32_nslot, xu32_t xu32_count) const
+    {
+        const xu32_t * xslot_ptr = table< xu32_t >(xu32_offset);
+
+        bool xbt_empty = false;
+        for (xu32_t xu32_iter = 0; xu32_iter < xu32_nslot; ++xu32_iter)
+        {
+            if (XIMAGE_EMPTY == xslot_ptr[xu32_iter])
+                xbt_empty = true;
+            else if (xslot_ptr[xu32_iter] > xu32_count)
+                return false;
+        }
+
+        return xbt_empty;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 校验字符串池中的 [xu32_offset, xu32_offset + xu32_size] 位于池内，且以 '\0' 结尾。
+     */
+    inline bool check_name(xu32_t xu32_offset, xu32_t xu32_size) const
+    {
+        return (((static_cast< xu64_t >(xu32_offset) + xu32_size) < head()->m_xu32_npool) &&
+                ('\0' == pool(xu32_offset)[xu32_size]));
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 校验数据块是否位于映像之内（且 4 字节对齐）。
+     */
+    inline bool check_block(xu32_t xu32_offset, xu64_t xu64_size) const
+    {
+        return ((xu32_offset >= sizeof(xhead_t)) &&
+                (0 == (xu32_offset & 3)) &&
+                ((xu32_offset + xu64_size) <= m_xst_isize));
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 比对字符串池中的名称 与 [xszt_beg, xszt_end) 区间（忽略大小写）。
+     */
+    bool same_name(xu32_t xu32_name, xu32_t xu32_nlen, const char * xszt_beg, const char * xszt_end) const
+    {
+        if (static_cast< size_t >(xszt_end - xszt_beg) != xu32_nlen)
+        {
+            return false;
+        }
+
+        const char * xszt_name = pool(xu32_name);
+        for (; xszt_beg != xszt_end; ++xszt_beg, ++xszt_name)
+        {
+            if (fold(*xszt_beg) != fold(*xszt_name))
+                return false;
+        }
+
+        return true;
+    }
+
+    inline const xhead_t * head(void) const
+    {
+        return reinterpret_cast< const xhead_t * >(m_ximage_ptr);
+    }
+
+    template< typename __record_type >
+    inline const __record_type * table(xu32_t xu32_offset) const
+    {
+        return reinterpret_cast< const __record_type * >(m_ximage_ptr + xu32_offset);
+    }
+
+    inline const char * pool(xu32_t xu32_offset) const
+    {
+        return (m_ximage_ptr + head()->m_xu32_opool + xu32_offset);
+    }
+
+    inline const xsect_rec_t & sect_rec(size_t xst_sect) const
+    {
+        assert(xst_sect < sect_count());
+        return table< xsect_rec_t >(head()->m_xu32_osect)[xst_sect];
+    }
+
+    inline const xkey_rec_t & key_rec(size_t xst_sect, size_t xst_key) const
+    {
+        const xsect_rec_t & xsect = sect_rec(xst_sect);
+        assert(xst_key < xsect.m_xu32_kcnt);
+        return table< xkey_rec_t >(head()->m_xu32_okey)[xsect.m_xu32_kbeg + xst_key];
+    }
+
+    // data members
+protected:
+    const char * m_ximage_ptr;  ///< 映像内存（映射地址）
+    size_t       m_xst_isize;   ///< 映像大小
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XINI_IMAGE_H__
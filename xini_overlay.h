@@ -0,0 +1,401 @@
+﻿/**
+ * The MIT License (MIT)
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file xini_overlay.h
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * @author  ：Gaaagaa
+ * @date    : 2026-10-19
+ * @version : 1.0.0.0
+ * @brief   : 多个 xini_file_t 对象按优先级层叠的只读视图（如 默认配置 -> 站点配置 -> 主机配置）。
+ */
+
+#ifndef __XINI_OVERLAY_H__
+#define __XINI_OVERLAY_H__
+
+#include "xini_file.h"
+
+#include <vector>
+
+#ifdef XINI_CXX11
+#include <unordered_map>
+#endif // XINI_CXX11
+
+////////////////////////////////////////////////////////////////////////////////
+// xini_overlay_t
+
+/**
+ * @class xini_overlay_t
+ * @brief 层叠配置视图：后加入的层 优先级更高，查找时返回优先级最高的层中的键值。
+ *
+ * <pre>
+ * 各层保存的是 xini_file_t 的克隆对象（写时复制，不复制键值），
+ * 并为所有层建立一份合并的索引：（分节名, 键名） -> 各层中的键值节点，
+ * 查找只需一次索引操作（C++11 下为哈希表），并可得知键值来自哪一层。
+ * 某一层重新加载后，调用 update_layer() 只需重建该层所涉及的索引项。
+ *
+ * 使用示例：
+ *  xini_overlay_t xoverlay;
+ *  xoverlay.push_layer(xini_defaults, "defaults");
+ *  xoverlay.push_layer(xini_site    , "site"    );
+ *  xoverlay.push_layer(xini_host    , "host"    );
+ *  int    port  = xoverlay("db", "port");
+ *  size_t layer = xoverlay.layer_of("db", "port");
+ * </pre>
+ */
+class xini_overlay_t
+{
+    // common data types
+public:
+    /** 键值不存在时，layer_of() 的返回值 */
+    static const size_t npos = static_cast< size_t >(-1);
+
+protected:
+    typedef std::vector< const xini_keyvalue_t * > xvec_knode_t;
+
+    /**
+     * @struct xentry_t
+     * @brief  合并索引中的索引项。
+     */
+    struct xentry_t
+    {
+        xvec_knode_t m_xvec_knode;  ///< 各层中的键值节点（下标为层号，不存在时为 NULL）
+        size_t       m_xst_layer;   ///< 生效的（优先级最高的）层号
+
+        xentry_t(void) : m_xst_layer(npos) { }
+    };
+
+#ifdef XINI_CXX11
+    typedef std::unordered_map< std::string, xentry_t > xmap_entry_t;
+#else // !XINI_CXX11
+    typedef std::map< std::string, xentry_t > xmap_entry_t;
+#endif // XINI_CXX11
+
+    /**
+     * @struct xlayer_t
+     * @brief  配置层。
+     */
+    struct xlayer_t
+    {
+        std::string                m_xstr_name;  ///< 层名称
+        xini_file_t                m_xini_file;  ///< 克隆对象（写时复制）
+        std::vector< std::string > m_xvec_index; ///< 该层所涉及的索引项
+    };
+
+    // constructor/destructor
+public:
+    xini_overlay_t(void)
+    {
+
+    }
+
+    ~xini_overlay_t(void)
+    {
+
+    }
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 加入一层配置（优先级高于已有的各层）。
+     * 
+     * @param [in ] xini_file : 配置对象（保存其克隆对象，之后对原对象的修改不会影响视图）。
+     * @param [in ] xstr_name : 层名称。
+     * 
+     * @return size_t : 层号。
+     */
+    size_t push_layer(const xini_file_t & xini_file, const std::string & xstr_name = std::string())
+    {
+        m_xvec_layer.push_back(xlayer_t());
+        m_xvec_layer.back().m_xstr_name = xstr_name;
+
+        size_t xst_layer = m_xvec_layer.size() - 1;
+        index_layer(xst_layer, xini_file);
+        return xst_layer;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 更新某一层的配置（如 该层文件重新加载后），只重建该层所涉及的索引项。
+     * 
+     * @return bool : 层号无效时，返回 false 。
+     */
+    bool update_layer(size_t xst_layer, const xini_file_t & xini_file)
+    {
+        if (xst_layer >= m_xvec_layer.size())
+        {
+            return false;
+        }
+
+        unindex_layer(xst_layer);
+        index_layer(xst_layer, xini_file);
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 层的数量。
+     */
+    inline size_t layer_count(void) const { return m_xvec_layer.size(); }
+
+    /**********************************************************/
+    /**
+     * @brief 层的名称。
+     */
+    inline const std::string & layer_name(size_t xst_layer) const
+    {
+        return m_xvec_layer.at(xst_layer).m_xstr_name;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 层的配置对象。
+     */
+    inline const xini_file_t & layer(size_t xst_layer) const
+    {
+        return m_xvec_layer.at(xst_layer).m_xini_file;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 合并索引中的键值数量。
+     */
+    inline size_t size(void) const { return m_xmap_entry.size(); }
+
+    /**********************************************************/
+    /**
+     * @brief 查找键值（优先级最高的层中的键值）。
+     * 
+     * @param [in ] xstr_sect  : 分节名。
+     * @param [in ] xstr_key   : 键名。
+     * @param [out] xlayer_ptr : 可为 NULL，返回键值所在的层号（不存在时为 npos）。
+     * 
+     * @return const xini_keyvalue_t * : 不存在时返回 NULL 。
+     */
+    const xini_keyvalue_t * find(const std::string & xstr_sect,
+                                 const std::string & xstr_key,
+                                 size_t * xlayer_ptr = NULL) const
+    {
+        xmap_entry_t::const_iterator itmap =
+            m_xmap_entry.find(index_name(xstr_sect, xstr_key));
+        if (itmap == m_xmap_entry.end())
+        {
+            if (NULL != xlayer_ptr)
+                *xlayer_ptr = npos;
+            return NULL;
+        }
+
+        const xentry_t & xentry = itmap->second;
+        if (NULL != xlayer_ptr)
+            *xlayer_ptr = xentry.m_xst_layer;
+        return xentry.m_xvec_knode[xentry.m_xst_layer];
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 查找键值在指定层中的节点（用于比对各层的取值）。
+     */
+    const xini_keyvalue_t * find_in(const std::string & xstr_sect,
+                                    const std::string & xstr_key,
+                                    size_t xst_layer) const
+    {
+        xmap_entry_t::const_iterator itmap =
+            m_xmap_entry.find(index_name(xstr_sect, xstr_key));
+        if ((itmap == m_xmap_entry.end()) ||
+            (xst_layer >= itmap->second.m_xvec_knode.size()))
+        {
+            return NULL;
+        }
+
+        return itmap->second.m_xvec_knode[xst_layer];
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 键值所在的层号（不存在时返回 npos）。
+     */
+    size_t layer_of(const std::string & xstr_sect, const std::string & xstr_key) const
+    {
+        size_t xst_layer = npos;
+        find(xstr_sect, xstr_key, &xst_layer);
+        return xst_layer;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 只读索引操作，不存在时返回空键值节点，
+     *        可直接转换为 基础数据类型，如 int port = xoverlay("db", "port"); 。
+     */
+    const xini_keyvalue_t & operator () (const std::string & xstr_sect,
+                                         const std::string & xstr_key) const
+    {
+        const xini_keyvalue_t * xndkv_ptr = find(xstr_sect, xstr_key);
+        if (NULL != xndkv_ptr)
+        {
+            return *xndkv_ptr;
+        }
+
+        static const xini_file_t xnil_file;
+        return xnil_file[std::string()][std::string()];
+    }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 修剪字符串前后端的字符集（与 xini_file_t 中 分节名/键名 的修剪规则一致）。
+     */
+    static std::string trim_name(const std::string & xstr, const char * xchars)
+    {
+        std::string::size_type xst_pos = xstr.find_first_not_of(xchars);
+        if (std::string::npos == xst_pos)
+        {
+            return std::string();
+        }
+
+        return xstr.substr(xst_pos, xstr.find_last_not_of(xchars) - xst_pos + 1);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 合并索引中的 索引名（修剪 分节名/键名 后，转为小写，与 xstr_icmp() 一致）。
+     */
+    static std::string index_name(const std::string & xstr_sect, const std::string & xstr_key)
+    {
+        std::string xstr_sname = trim_name(xstr_sect, "[] \t\n\r\f\v");
+        std::string xstr_kname = trim_name(xstr_key , XCHARS_TRIM);
+
+        std::string xstr_name;
+        xstr_name.reserve(xstr_sname.size() + xstr_kname.size() + 1);
+        xstr_name.append(xstr_sname).append(1, '\n').append(xstr_kname);
+
+        for (std::string::iterator
+                itstr  = xstr_name.begin();
+                itstr != xstr_name.end();
+                ++itstr)
+        {
+            if ((*itstr >= 'A') && (*itstr <= 'Z'))
+                *itstr += ('a' - 'A');
+        }
+
+        return xstr_name;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 重新计算索引项中生效的层号。
+     */
+    static void settle_entry(xentry_t & xentry)
+    {
+        xentry.m_xst_layer = npos;
+        for (size_t xst_iter = xentry.m_xvec_knode.size(); xst_iter > 0; --xst_iter)
+        {
+            if (NULL != xentry.m_xvec_knode[xst_iter - 1])
+            {
+                xentry.m_xst_layer = xst_iter - 1;
+                break;
+            }
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 将配置对象设置为指定层，并将其各个键值加入合并索引。
+     */
+    void index_layer(size_t xst_layer, const xini_file_t & xini_file)
+    {
+        xlayer_t & xlayer = m_xvec_layer[xst_layer];
+
+        // 克隆对象只用于读取，清除脏标识，避免析构时回写文件
+        xlayer.m_xini_file = xini_file;
+        xlayer.m_xini_file.set_dirty(false);
+        xlayer.m_xvec_index.clear();
+
+        // 索引项直接记录 克隆对象 中的键值节点：克隆对象只经由 const 接口访问，
+        // 不会复制分节；源对象 克隆前取得的 分节/键值 引用 已不可写入
+        // （参看 xini_node_t::is_writable()），源对象经由自身写入时，
+        // 复制出独占的分节，故这些节点 在克隆对象 重新赋值前 始终有效
+        const xini_file_t & xfile_cref = xlayer.m_xini_file;
+        for (xini_file_t::const_iterator
+                itsect  = xfile_cref.begin();
+                itsect != xfile_cref.end();
+                ++itsect)
+        {
+            const xini_section_t * xsect_ptr = *itsect;
+            for (xini_section_t::kv_const_iterator
+                    itkv  = xsect_ptr->kv_begin();
+                    itkv != xsect_ptr->kv_end();
+                    ++itkv)
+            {
+                std::string xstr_name = index_name(xsect_ptr->name(), (*itkv)->key());
+
+                xentry_t & xentry = m_xmap_entry[xstr_name];
+                if (xentry.m_xvec_knode.size() <= xst_layer)
+                    xentry.m_xvec_knode.resize(xst_layer + 1, NULL);
+                xentry.m_xvec_knode[xst_layer] = *itkv;
+                if ((npos == xentry.m_xst_layer) || (xentry.m_xst_layer < xst_layer))
+                    xentry.m_xst_layer = xst_layer;
+
+                xlayer.m_xvec_index.push_back(xstr_name);
+            }
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 从合并索引中移除指定层的各个键值（只访问该层所涉及的索引项）。
+     */
+    void unindex_layer(size_t xst_layer)
+    {
+        xlayer_t & xlayer = m_xvec_layer[xst_layer];
+
+        for (std::vector< std::string >::const_iterator
+                itvec  = xlayer.m_xvec_index.begin();
+                itvec != xlayer.m_xvec_index.end();
+                ++itvec)
+        {
+            xmap_entry_t::iterator itmap = m_xmap_entry.find(*itvec);
+            if (itmap == m_xmap_entry.end())
+                continue;
+
+            xentry_t & xentry = itmap->second;
+            xentry.m_xvec_knode[xst_layer] = NULL;
+            if (xentry.m_xst_layer == xst_layer)
+                settle_entry(xentry);
+            if (npos == xentry.m_xst_layer)
+                m_xmap_entry.erase(itmap);
+        }
+
+        xlayer.m_xvec_index.clear();
+    }
+
+    // data members
+protected:
+    std::vector< xlayer_t > m_xvec_layer;  ///< 各个配置层（层号越大，优先级越高）
+    xmap_entry_t            m_xmap_entry;  ///< 合并索引
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XINI_OVERLAY_H__
@@ -0,0 +1,427 @@
+﻿/**
+ * The MIT License (MIT)
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file xini_query.h
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * @author  ：Gaaagaa
+ * @date    : 2026-10-19
+ * @version : 1.0.0.0
+ * @brief   : 按 分节名/键名/键值 的 通配符 或 正则表达式 并行检索 xini_file_t
+ *            （需要 C++14 及以上版本）。
+ */
+
+#ifndef __XINI_QUERY_H__
+#define __XINI_QUERY_H__
+
+#include "xini_file.h"
+#include "xini_tpool.h"
+
+#include <algorithm>
+#include <memory>
+#include <regex>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 并行检索时，每个任务所处理的分节数量 */
+#ifndef XINI_QUERY_GRAIN
+#define XINI_QUERY_GRAIN 256
+#endif // XINI_QUERY_GRAIN
+
+////////////////////////////////////////////////////////////////////////////////
+// xini_query_t
+
+/**
+ * @class xini_query_t
+ * @brief 分节名/键名/键值 的组合检索条件，结果按文件中的先后次序返回。
+ *
+ * <pre>
+ * 分节名、键名 的匹配忽略大小写（与 xini_file_t 的索引规则一致），
+ * 键值 的匹配区分大小写；未设置的条件视为匹配全部。
+ * 通配符支持 *、?、[abc]、[a-z]、[!abc]（或 [^abc]）。
+ *
+ * 检索时将分节表按 XINI_QUERY_GRAIN 个分节一组切分为多个任务，
+ * 由线程池并行处理，各组结果再按组的次序拼接，保证与文件次序一致。
+ * 检索只使用 xini_file_t 的 const 接口，检索期间不可有其他线程修改该对象
+ * （可配合 xini_shared_t::read() 或 xini_snapshot_t 使用）。
+ *
+ * 使用示例：
+ *  xini_query_t xquery;
+ *  xquery.value("^/tmp/", xini_query_t::XQUERY_REGEX);
+ *  std::vector< xini_query_t::xmatch_t > xvec = xquery.select(xini_file);
+ * </pre>
+ */
+class xini_query_t
+{
+    // common data types
+public:
+    /**
+     * @enum  xmode_t
+     * @brief 匹配模式。
+     */
+    typedef enum xmode_t
+    {
+        XQUERY_ANY   = 0,  ///< 匹配全部
+        XQUERY_GLOB  = 1,  ///< 通配符
+        XQUERY_REGEX = 2,  ///< 正则表达式（ECMAScript 语法，部分匹配即可，可用 ^$ 锚定）
+    } xmode_t;
+
+    /**
+     * @struct xmatch_t
+     * @brief  检索结果（指针在 xini_file_t 对象被修改前有效）。
+     */
+    typedef struct xmatch_t
+    {
+        const xini_section_t  * m_xsect_ptr;  ///< 所属分节
+        const xini_keyvalue_t * m_xndkv_ptr;  ///< 键值节点
+    } xmatch_t;
+
+    typedef std::vector< xmatch_t > xvec_match_t;
+
+protected:
+    /**
+     * @class xpattern_t
+     * @brief 单项匹配条件。
+     */
+    class xpattern_t
+    {
+    public:
+        xpattern_t(void)
+            : m_xmode(XQUERY_ANY)
+            , m_xbt_icase(false)
+        {
+
+        }
+
+    public:
+        /**********************************************************/
+        /**
+         * @brief 设置匹配条件。
+         * 
+         * @return bool : 正则表达式语法错误时返回 false（此时条件保持不变）。
+         */
+        bool assign(const std::string & xstr_pattern, int xmode, bool xbt_icase)
+        {
+            std::shared_ptr< std::regex > xregex_sptr;
+            if (XQUERY_REGEX == xmode)
+            {
+                std::regex::flag_type xflags = std::regex::ECMAScript | std::regex::optimize;
+                if (xbt_icase)
+                    xflags |= std::regex::icase;
+
+                try
+                {
+                    xregex_sptr = std::make_shared< std::regex >(xstr_pattern, xflags);
+                }
+                catch (const std::regex_error &)
+                {
+                    return false;
+                }
+            }
+
+            m_xmode       = xmode;
+            m_xbt_icase   = xbt_icase;
+            m_xstr_glob   = xstr_pattern;
+            m_xregex_sptr = xregex_sptr;
+
+            return true;
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 判断字符串是否满足匹配条件。
+         */
+        bool match(const std::string & xstr) const
+        {
+            switch (m_xmode)
+            {
+            case XQUERY_GLOB : return glob_match(m_xstr_glob.c_str(), xstr.c_str(), m_xbt_icase);
+            case XQUERY_REGEX: return std::regex_search(xstr, *m_xregex_sptr);
+            default          : break;
+            }
+
+            return true;
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 通配符匹配（'*' 处回溯，时间复杂度 O(m * n)）。
+         */
+        static bool glob_match(const char * xszt_glob, const char * xszt_text, bool xbt_icase)
+        {
+            const char * xszt_star = NULL;  // 最近一次 '*' 之后的位置
+            const char * xszt_back = NULL;  // 最近一次 '*' 匹配到的文本位置
+
+            while ('\0' != *xszt_text)
+            {
+                const char * xszt_next = NULL;
+
+                if ('*' == *xszt_glob)
+                {
+                    xszt_star = ++xszt_glob;
+                    xszt_back = xszt_text;
+                    continue;
+                }
+
+                if ('?' == *xszt_glob)
+                    xszt_next = xszt_glob + 1;
+                else if ('[' == *xszt_glob)
+                    xszt_next = glob_class(xszt_glob, *xszt_text, xbt_icase);
+                else if (('\0' != *xszt_glob) && ceq(*xszt_glob, *xszt_text, xbt_icase))
+                    xszt_next = xszt_glob + 1;
+
+                if (NULL != xszt_next)
+                {
+                    xszt_glob = xszt_next;
+                    ++xszt_text;
+                }
+                else if (NULL != xszt_star)
+                {
+                    xszt_glob = xszt_star;
+                    xszt_text = ++xszt_back;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            while ('*' == *xszt_glob)
+                ++xszt_glob;
+
+            return ('\0' == *xszt_glob);
+        }
+
+    protected:
+        /**********************************************************/
+        /**
+         * @brief 字符比对（可忽略 ASCII 大小写）。
+         */
+        static inline bool ceq(char xch_left, char xch_right, bool xbt_icase)
+        {
+            if (xbt_icase)
+            {
+                if ((xch_left  >= 'A') && (xch_left  <= 'Z')) xch_left  += ('a' - 'A');
+                if ((xch_right >= 'A') && (xch_right <= 'Z')) xch_right += ('a' - 'A');
+            }
+
+            return (xch_left == xch_right);
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 匹配 [...] 字符集。
+         * 
+         * @return const char * : 匹配成功时返回 ']' 之后的位置，否则返回 NULL；
+         *                        字符集未闭合时，'[' 按普通字符处理。
+         */
+        static const char * glob_class(const char * xszt_glob, char xch_text, bool xbt_icase)
+        {
+            const char * xszt_iter = xszt_glob + 1;
+            bool xbt_negate = (('!' == *xszt_iter) || ('^' == *xszt_iter));
+            if (xbt_negate)
+                ++xszt_iter;
+
+            bool xbt_match = false;
+            bool xbt_first = true;
+            for (; ('\0' != *xszt_iter) && (xbt_first || (']' != *xszt_iter)); ++xszt_iter)
+            {
+                xbt_first = false;
+
+                if (('-' == xszt_iter[1]) && ('\0' != xszt_iter[2]) && (']' != xszt_iter[2]))
+                {
+                    char xch_lower = xszt_iter[0];
+                    char xch_upper = xszt_iter[2];
+
+                    char xch_lcase = xch_text;
+                    char xch_ucase = xch_text;
+                    if (xbt_icase && (xch_text >= 'A') && (xch_text <= 'Z'))
+                        xch_lcase += ('a' - 'A');
+                    if (xbt_icase && (xch_text >= 'a') && (xch_text <= 'z'))
+                        xch_ucase -= ('a' - 'A');
+
+                    if (((xch_lcase >= xch_lower) && (xch_lcase <= xch_upper)) ||
+                        ((xch_ucase >= xch_lower) && (xch_ucase <= xch_upper)))
+                    {
+                        xbt_match = true;
+                    }
+
+                    xszt_iter += 2;
+                }
+                else if (ceq(*xszt_iter, xch_text, xbt_icase))
+                {
+                    xbt_match = true;
+                }
+            }
+
+            if ('\0' == *xszt_iter)
+            {
+                return ('[' == xch_text) ? (xszt_glob + 1) : NULL;
+            }
+
+            return (xbt_match != xbt_negate) ? (xszt_iter + 1) : NULL;
+        }
+
+    public:
+        int                            m_xmode;        ///< 匹配模式
+        bool                           m_xbt_icase;    ///< 是否忽略大小写
+        std::string                    m_xstr_glob;    ///< 通配符
+        std::shared_ptr< std::regex >  m_xregex_sptr;  ///< 正则表达式（只读共享，可并发匹配）
+    };
+
+    // constructor/destructor
+public:
+    xini_query_t(void)
+    {
+
+    }
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 设置 分节名 的匹配条件（忽略大小写）。
+     * 
+     * @return bool : 正则表达式语法错误时返回 false。
+     */
+    bool sect(const std::string & xstr_pattern, int xmode = XQUERY_GLOB)
+    {
+        return m_xsect.assign(xstr_pattern, xmode, true);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 设置 键名 的匹配条件（忽略大小写）。
+     * 
+     * @return bool : 正则表达式语法错误时返回 false。
+     */
+    bool key(const std::string & xstr_pattern, int xmode = XQUERY_GLOB)
+    {
+        return m_xkey.assign(xstr_pattern, xmode, true);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 设置 键值 的匹配条件（区分大小写）。
+     * 
+     * @return bool : 正则表达式语法错误时返回 false。
+     */
+    bool value(const std::string & xstr_pattern, int xmode = XQUERY_GLOB)
+    {
+        return m_xvalue.assign(xstr_pattern, xmode, false);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 检索 xini_file_t 对象，返回满足全部条件的键值（按文件次序）。
+     * 
+     * @param [in ] xini_file : 检索的目标对象。
+     * @param [in ] xtpool    : 执行检索的线程池。
+     */
+    xvec_match_t select(const xini_file_t & xini_file,
+                        xini_tpool_t & xtpool = xini_tpool_t::instance()) const
+    {
+        std::vector< const xini_section_t * > xvec_sect;
+        xvec_sect.reserve(xini_file.sect_count());
+        for (xini_file_t::const_iterator
+                itsect  = xini_file.begin();
+                itsect != xini_file.end();
+                ++itsect)
+        {
+            xvec_sect.push_back(*itsect);
+        }
+
+        //======================================
+        // 按组切分，各组结果独立存放，最后按组的次序拼接
+
+        const size_t xst_grain = XINI_QUERY_GRAIN;
+        const size_t xst_tasks = (xvec_sect.size() + xst_grain - 1) / xst_grain;
+        std::vector< xvec_match_t > xvec_parts(xst_tasks);
+
+        xtpool.parallel_for(xst_tasks,
+            [&](size_t xst_index)
+            {
+                size_t xst_begin = xst_index * xst_grain;
+                size_t xst_end   = std::min(xst_begin + xst_grain, xvec_sect.size());
+                for (size_t xst_iter = xst_begin; xst_iter < xst_end; ++xst_iter)
+                {
+                    select_sect(*xvec_sect[xst_iter], xvec_parts[xst_index]);
+                }
+            });
+
+        size_t xst_total = 0;
+        for (size_t xst_iter = 0; xst_iter < xst_tasks; ++xst_iter)
+        {
+            xst_total += xvec_parts[xst_iter].size();
+        }
+
+        xvec_match_t xvec_match;
+        xvec_match.reserve(xst_total);
+        for (size_t xst_iter = 0; xst_iter < xst_tasks; ++xst_iter)
+        {
+            xvec_match.insert(xvec_match.end(),
+                              xvec_parts[xst_iter].begin(),
+                              xvec_parts[xst_iter].end());
+        }
+
+        return xvec_match;
+    }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 检索单个分节。
+     */
+    void select_sect(const xini_section_t & xsect, xvec_match_t & xvec_match) const
+    {
+        if (!m_xsect.match(xsect.name()))
+        {
+            return;
+        }
+
+        for (xini_section_t::kv_const_iterator
+                itkv  = xsect.kv_begin();
+                itkv != xsect.kv_end();
+                ++itkv)
+        {
+            const xini_keyvalue_t * xndkv_ptr = *itkv;
+            if (m_xkey.match(xndkv_ptr->key()) && m_xvalue.match(xndkv_ptr->value()))
+            {
+                xmatch_t xmatch = { &xsect, xndkv_ptr };
+                xvec_match.push_back(xmatch);
+            }
+        }
+    }
+
+    // data members
+protected:
+    xpattern_t m_xsect;   ///< 分节名 的匹配条件
+    xpattern_t m_xkey;    ///< 键名 的匹配条件
+    xpattern_t m_xvalue;  ///< 键值 的匹配条件
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XINI_QUERY_H__
@@ -0,0 +1,872 @@
+﻿/**
+ * The MIT License (MIT)
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file xini_shared.h
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * @author  ：Gaaagaa
+ * @date    : 2026-10-19
+ * @version : 1.0.0.0
+ * @brief   : xini_file_t 的多线程并发访问封装（需要 C++14 及以上版本）。
+ *            xini_shared_t   : 分片读写锁，多读单写；
+ *            xini_sharded_t  : 分节级读写锁，不同分节的写操作可并行；
+ *            xini_snapshot_t : 不可变快照 + 原子发布，读操作无锁（用于热加载）。
+ */
+
+#ifndef __XINI_SHARED_H__
+#define __XINI_SHARED_H__
+
+#include "xini_file.h"
+
+#ifndef XINI_CXX14
+#error "xini_shared.h requires C++14"
+#endif // XINI_CXX14
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 读锁的分片数量（写操作需要锁定全部分片，读操作只锁定所属分片） */
+#ifndef XINI_SHARED_STRIPES
+#define XINI_SHARED_STRIPES 64
+#endif // XINI_SHARED_STRIPES
+
+/** 读写锁分片的缓存行对齐字节数 */
+#ifndef XINI_CACHELINE_SIZE
+#define XINI_CACHELINE_SIZE 64
+#endif // XINI_CACHELINE_SIZE
+
+////////////////////////////////////////////////////////////////////////////////
+// xini_shared_t
+
+/**
+ * @class xini_shared_t
+ * @brief xini_file_t 的并发访问封装（多读单写）。
+ *
+ * <pre>
+ * 读操作只使用 xini_file_t 的 const 接口（只读 operator [] 等），
+ * 不会修改内部数据，所以多个线程可以并行读取；
+ * 写操作（包括非 const 的 operator []）则走独占路径。
+ *
+ * 若所有读线程共用一把读写锁，读锁的计数器会在各个 CPU 核心间来回传递，
+ * 核心数越多，冲突越严重。所以此处将读写锁分片（按缓存行对齐）：
+ * 每个线程的读操作只锁定其所属分片，不同线程之间基本无缓存行竞争；
+ * 写操作则按顺序锁定全部分片。读多写少时，读性能随核心数线性扩展。
+ *
+ * 使用示例：
+ *  xini_shared_t xini_shared("test.ini");
+ *  int num = xini_shared.get("分节", "键", 1000);
+ *  xini_shared.set("分节", "键", 2000);
+ *  xini_shared.read([](const xini_file_t & xini_file) { ... });
+ *  xini_shared.write([](xini_file_t & xini_file) { ... });
+ * </pre>
+ */
+class xini_shared_t
+{
+    // common data types
+protected:
+#if (__cplusplus >= 201703L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L))
+    typedef std::shared_mutex       xmutex_t;
+#else // C++14
+    typedef std::shared_timed_mutex xmutex_t;
+#endif // __cplusplus >= 201703L
+
+    /**
+     * @struct xstripe_t
+     * @brief  按缓存行对齐的读写锁分片。
+     */
+    struct alignas(XINI_CACHELINE_SIZE) xstripe_t
+    {
+        mutable xmutex_t m_xmutex;
+    };
+
+public:
+    /**
+     * @class rlock_t
+     * @brief 读锁守卫，持有期间可进行多次只读访问。
+     */
+    class rlock_t
+    {
+    public:
+        explicit rlock_t(const xini_shared_t & xshared)
+            : m_xshared(xshared)
+            , m_xstripe(xshared.m_xstripe[stripe_index()].m_xmutex)
+        {
+            m_xstripe.lock_shared();
+        }
+
+        ~rlock_t(void)
+        {
+            m_xstripe.unlock_shared();
+        }
+
+        rlock_t(const rlock_t &) = delete;
+        rlock_t & operator = (const rlock_t &) = delete;
+
+    public:
+        inline const xini_file_t & file(void) const { return m_xshared.m_xini_file; }
+        inline const xini_file_t * operator -> (void) const { return &file(); }
+
+        inline const xini_section_t & operator [] (const std::string & xstr_sect) const
+        {
+            return file()[xstr_sect];
+        }
+
+    private:
+        const xini_shared_t & m_xshared;
+        xmutex_t            & m_xstripe;
+    };
+
+    /**
+     * @class wlock_t
+     * @brief 写锁守卫，持有期间独占访问 xini_file_t 对象。
+     */
+    class wlock_t
+    {
+    public:
+        explicit wlock_t(xini_shared_t & xshared)
+            : m_xshared(xshared)
+        {
+            m_xshared.lock_all();
+        }
+
+        ~wlock_t(void)
+        {
+            m_xshared.unlock_all();
+        }
+
+        wlock_t(const wlock_t &) = delete;
+        wlock_t & operator = (const wlock_t &) = delete;
+
+    public:
+        inline xini_file_t & file(void) const { return m_xshared.m_xini_file; }
+        inline xini_file_t * operator -> (void) const { return &file(); }
+
+        inline xini_section_t & operator [] (const std::string & xstr_sect) const
+        {
+            return file()[xstr_sect];
+        }
+
+    private:
+        xini_shared_t & m_xshared;
+    };
+
+    friend class rlock_t;
+    friend class wlock_t;
+
+    // common invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 当前线程所属的读锁分片索引（线程首次调用时轮流分配）。
+     */
+    static inline size_t stripe_index(void)
+    {
+        static std::atomic< size_t > xst_next(0);
+        static thread_local size_t xst_index =
+            xst_next.fetch_add(1, std::memory_order_relaxed) % XINI_SHARED_STRIPES;
+        return xst_index;
+    }
+
+    // constructor/destructor
+public:
+    xini_shared_t(void)
+    {
+
+    }
+
+    explicit xini_shared_t(const std::string & xstr_filepath)
+        : m_xini_file(xstr_filepath)
+    {
+
+    }
+
+    ~xini_shared_t(void)
+    {
+
+    }
+
+    xini_shared_t(const xini_shared_t &) = delete;
+    xini_shared_t & operator = (const xini_shared_t &) = delete;
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 在读锁保护下执行 xfunc(const xini_file_t &)，返回其结果。
+     * @note  返回值不可引用 xini_file_t 内部的数据（如 const char *）。
+     */
+    template< typename __func_type >
+    auto read(__func_type xfunc) const
+        -> decltype(xfunc(std::declval< const xini_file_t & >()))
+    {
+        rlock_t xlock(*this);
+        return xfunc(xlock.file());
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 在写锁保护下执行 xfunc(xini_file_t &)，返回其结果。
+     */
+    template< typename __func_type >
+    auto write(__func_type xfunc)
+        -> decltype(xfunc(std::declval< xini_file_t & >()))
+    {
+        wlock_t xlock(*this);
+        return xfunc(xlock.file());
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 带默认值的读操作（键值为 空 或 不存在时，返回默认值）。
+     */
+    template< typename __value_type >
+    __value_type get(
+                    const std::string & xstr_sect,
+                    const std::string & xstr_key,
+                    __value_type x_default) const
+    {
+        rlock_t xlock(*this);
+        return xlock[xstr_sect][xstr_key](x_default);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 字符串的读操作（返回拷贝，避免在锁外引用内部数据）。
+     */
+    std::string get(
+                    const std::string & xstr_sect,
+                    const std::string & xstr_key,
+                    const char * x_default = "") const
+    {
+        rlock_t xlock(*this);
+        return std::string(xlock[xstr_sect][xstr_key](x_default));
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 字符串的读操作（返回拷贝，避免在锁外引用内部数据）。
+     */
+    std::string get(
+                    const std::string & xstr_sect,
+                    const std::string & xstr_key,
+                    const std::string & x_default) const
+    {
+        return get(xstr_sect, xstr_key, x_default.c_str());
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 判定是否包含指定的 键值（不会新增节点）。
+     */
+    bool contains(const std::string & xstr_sect, const std::string & xstr_key) const
+    {
+        rlock_t xlock(*this);
+        return xlock[xstr_sect].key_included(xstr_key);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 写操作（独占）。
+     */
+    template< typename __value_type >
+    void set(
+            const std::string & xstr_sect,
+            const std::string & xstr_key,
+            const __value_type & x_value)
+    {
+        wlock_t xlock(*this);
+        xlock[xstr_sect][xstr_key] = x_value;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 重新加载 INI 文件（独占）。
+     */
+    bool load(const std::string & xstr_filepath)
+    {
+        wlock_t xlock(*this);
+        return xlock->load(xstr_filepath);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 输出 INI 内容到文件（只需要读锁）。
+     */
+    bool dump(const std::string & xstr_filepath) const
+    {
+        rlock_t xlock(*this);
+        return xlock.file().dump(xstr_filepath);
+    }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 按固定顺序锁定全部分片（避免写线程之间死锁）。
+     */
+    void lock_all(void)
+    {
+        for (size_t xst_iter = 0; xst_iter < XINI_SHARED_STRIPES; ++xst_iter)
+        {
+            m_xstripe[xst_iter].m_xmutex.lock();
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 逆序解锁全部分片。
+     */
+    void unlock_all(void)
+    {
+        for (size_t xst_iter = XINI_SHARED_STRIPES; xst_iter > 0; --xst_iter)
+        {
+            m_xstripe[xst_iter - 1].m_xmutex.unlock();
+        }
+    }
+
+    // data members
+protected:
+    xstripe_t     m_xstripe[XINI_SHARED_STRIPES];  ///< 读写锁分片
+    xini_file_t   m_xini_file;                     ///< 被保护的 INI 文件对象
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// xini_sharded_t
+
+/**
+ * @class xini_sharded_t
+ * @brief xini_file_t 的分节级并发访问封装（不同分节的写操作可以并行）。
+ *
+ * <pre>
+ * 锁分为两级：
+ *  - 分节表锁：保护 xini_file_t 的分节表（增删分节、重命名分节、加载、输出等）；
+ *  - 分节锁  ：每个分节各自一把读写锁，保护该分节下的节点表。
+ * 对某个分节的读写操作，先持有 分节表锁 的共享锁，再持有 分节锁，
+ * 所以写不同分节的线程之间互不阻塞；新增分节 或 调用 write() 时，
+ * 才需要独占 分节表锁。
+ *
+ * 键值写操作最终会设置 xini_file_t 的脏标识，在 C++11 下该标识为原子变量，
+ * 多个分节并发写入时是安全的。
+ *
+ * 使用示例：
+ *  xini_sharded_t xini_sharded("test.ini");
+ *  // 线程 1                                    // 线程 2
+ *  xini_sharded.set("net", "port", 8080);       xini_sharded.set("log", "level", 3);
+ *  xini_sharded.write_sect("net", [](xini_section_t & xsect) { ... });
+ * </pre>
+ */
+class xini_sharded_t
+{
+    // common data types
+protected:
+#if (__cplusplus >= 201703L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L))
+    typedef std::shared_mutex       xmutex_t;
+#else // C++14
+    typedef std::shared_timed_mutex xmutex_t;
+#endif // __cplusplus >= 201703L
+
+    typedef std::unordered_map< const xini_section_t *,
+                                std::unique_ptr< xmutex_t > > xmap_mutex_t;
+
+    // constructor/destructor
+public:
+    xini_sharded_t(void)
+    {
+
+    }
+
+    explicit xini_sharded_t(const std::string & xstr_filepath)
+        : m_xini_file(xstr_filepath)
+    {
+        rebuild_mutex();
+    }
+
+    ~xini_sharded_t(void)
+    {
+
+    }
+
+    xini_sharded_t(const xini_sharded_t &) = delete;
+    xini_sharded_t & operator = (const xini_sharded_t &) = delete;
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 在分节读锁的保护下执行 xfunc(const xini_section_t &) 。
+     * @note  分节不存在时，xfunc 得到的是共享的 空分节。
+     */
+    template< typename __func_type >
+    auto read_sect(const std::string & xstr_sect, __func_type xfunc) const
+        -> decltype(xfunc(std::declval< const xini_section_t & >()))
+    {
+        std::shared_lock< xmutex_t > xlock_table(m_xmutex_table);
+
+        const xini_section_t & xsect = m_xini_file[xstr_sect];
+        xmap_mutex_t::const_iterator itfind = m_xmap_mutex.find(&xsect);
+        if (itfind == m_xmap_mutex.end())
+        {
+            return xfunc(xsect);
+        }
+
+        std::shared_lock< xmutex_t > xlock_sect(*itfind->second);
+        return xfunc(xsect);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 在分节写锁的保护下执行 xfunc(xini_section_t &)，分节不存在时先新增。
+     */
+    template< typename __func_type >
+    auto write_sect(const std::string & xstr_sect, __func_type xfunc)
+        -> decltype(xfunc(std::declval< xini_section_t & >()))
+    {
+        for (;;)
+        {
+            {
+                std::shared_lock< xmutex_t > xlock_table(m_xmutex_table);
+
+                const xini_file_t & xfile_cref = m_xini_file;
+                const xini_section_t & xsect = xfile_cref[xstr_sect];
+                xmap_mutex_t::iterator itfind = m_xmap_mutex.find(&xsect);
+
+                // 与克隆对象共享的分节，须在独占 分节表锁 时先行复制（写时复制）
+                if ((itfind != m_xmap_mutex.end()) &&
+                    !xfile_cref.is_shared() &&
+                    !xsect.is_shared() &&
+                    (xsect.get_owner() == &m_xini_file))
+                {
+                    std::unique_lock< xmutex_t > xlock_sect(*itfind->second);
+
+                    // 持有 分节表 共享锁期间，该分节不会被删除，
+                    // 而分节内的节点表 已由 分节锁 独占保护
+                    return xfunc(const_cast< xini_section_t & >(xsect));
+                }
+            }
+
+            // 分节不存在（或被共享），独占 分节表锁 新增（或复制）分节后，
+            // 重新走共享路径
+            std::unique_lock< xmutex_t > xlock_table(m_xmutex_table);
+            xini_section_t & xsect = m_xini_file[xstr_sect];
+            if (m_xmap_mutex.find(&xsect) == m_xmap_mutex.end())
+            {
+                m_xmap_mutex.insert(std::make_pair(
+                    &xsect, std::unique_ptr< xmutex_t >(new xmutex_t())));
+            }
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 独占整个 xini_file_t 执行 xfunc(xini_file_t &)（如删除/重命名分节）。
+     */
+    template< typename __func_type >
+    auto write(__func_type xfunc)
+        -> decltype(xfunc(std::declval< xini_file_t & >()))
+    {
+        std::unique_lock< xmutex_t > xlock_table(m_xmutex_table);
+        xrebuild_guard_t xguard(*this);
+        return xfunc(m_xini_file);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 在 分节表 共享锁的保护下执行 xfunc(const xini_file_t &) 。
+     * @note  期间其他线程仍可写分节，xfunc 只应访问不会被并发写入的数据。
+     */
+    template< typename __func_type >
+    auto read(__func_type xfunc) const
+        -> decltype(xfunc(std::declval< const xini_file_t & >()))
+    {
+        std::shared_lock< xmutex_t > xlock_table(m_xmutex_table);
+        return xfunc(m_xini_file);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 带默认值的读操作。
+     */
+    template< typename __value_type >
+    __value_type get(
+                    const std::string & xstr_sect,
+                    const std::string & xstr_key,
+                    __value_type x_default) const
+    {
+        return read_sect(xstr_sect,
+            [&](const xini_section_t & xsect) -> __value_type
+            {
+                return xsect[xstr_key](x_default);
+            });
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 字符串的读操作（返回拷贝）。
+     */
+    std::string get(
+                    const std::string & xstr_sect,
+                    const std::string & xstr_key,
+                    const char * x_default = "") const
+    {
+        return read_sect(xstr_sect,
+            [&](const xini_section_t & xsect) -> std::string
+            {
+                return std::string(xsect[xstr_key](x_default));
+            });
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 字符串的读操作（返回拷贝）。
+     */
+    std::string get(
+                    const std::string & xstr_sect,
+                    const std::string & xstr_key,
+                    const std::string & x_default) const
+    {
+        return get(xstr_sect, xstr_key, x_default.c_str());
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 写操作（只独占目标分节）。
+     */
+    template< typename __value_type >
+    void set(
+            const std::string & xstr_sect,
+            const std::string & xstr_key,
+            const __value_type & x_value)
+    {
+        write_sect(xstr_sect,
+            [&](xini_section_t & xsect)
+            {
+                xsect[xstr_key] = x_value;
+            });
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 重新加载 INI 文件。
+     */
+    bool load(const std::string & xstr_filepath)
+    {
+        return write([&](xini_file_t & xini_file) { return xini_file.load(xstr_filepath); });
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 输出 INI 内容到文件（独占，保证输出的内容是一致的）。
+     */
+    bool dump(const std::string & xstr_filepath)
+    {
+        std::unique_lock< xmutex_t > xlock_table(m_xmutex_table);
+        return m_xini_file.dump(xstr_filepath);
+    }
+
+    // inner invoking
+protected:
+    /**
+     * @struct xrebuild_guard_t
+     * @brief  write() 结束后（包括异常退出）重建分节锁表。
+     */
+    struct xrebuild_guard_t
+    {
+        xini_sharded_t & m_xsharded;
+        explicit xrebuild_guard_t(xini_sharded_t & xsharded) : m_xsharded(xsharded) { }
+        ~xrebuild_guard_t(void) { m_xsharded.rebuild_mutex(); }
+    };
+
+    /**********************************************************/
+    /**
+     * @brief 按当前分节表重建分节锁表（调用前须独占 分节表锁）。
+     */
+    void rebuild_mutex(void)
+    {
+        xmap_mutex_t xmap_mutex;
+        xmap_mutex.reserve(m_xini_file.sect_count());
+
+        // 分节锁只保护当前对象独占的分节，先解除与克隆对象之间的共享
+        m_xini_file.detach();
+
+        const xini_file_t & xfile_cref = m_xini_file;
+        for (xini_file_t::const_iterator itsect = xfile_cref.begin();
+             itsect != xfile_cref.end();
+             ++itsect)
+        {
+            xmap_mutex_t::iterator itfind = m_xmap_mutex.find(*itsect);
+            if (itfind != m_xmap_mutex.end())
+                xmap_mutex.insert(std::make_pair(*itsect, std::move(itfind->second)));
+            else
+                xmap_mutex.insert(std::make_pair(
+                    *itsect, std::unique_ptr< xmutex_t >(new xmutex_t())));
+        }
+
+        m_xmap_mutex.swap(xmap_mutex);
+    }
+
+    // data members
+protected:
+    mutable xmutex_t  m_xmutex_table;  ///< 分节表锁
+    xmap_mutex_t      m_xmap_mutex;    ///< 各个分节的读写锁（只在独占 分节表锁 时修改）
+    xini_file_t       m_xini_file;     ///< 被保护的 INI 文件对象
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// xini_snapshot_t
+
+/**
+ * @class xini_snapshot_t
+ * @brief INI 文件的不可变快照发布器（RCU 风格的热加载）。
+ *
+ * <pre>
+ * 加载线程在锁外解析出新的 xini_file_t 对象，清除其脏标识后冻结为 const，
+ * 再原子地发布出去；读线程始终使用自己已获取的快照，从不阻塞。
+ * 旧快照由引用计数回收：最后一个读者放弃引用后，
+ * 由发布线程在下一次 publish()/collect() 时析构，析构开销不会落在读线程上。
+ *
+ * 读线程应持有各自的 reader_t 对象：在快照未更新时，
+ * reader_t::get() 只有一次原子读操作（比较版本号），不加任何锁。
+ *
+ * 使用示例：
+ *  xini_snapshot_t xini_snapshot("test.ini");
+ *  // 读线程
+ *  xini_snapshot_t::reader_t xreader(xini_snapshot);
+ *  int num = xreader.get()["分节"]["键"](1000);
+ *  // 加载线程
+ *  xini_snapshot.reload();
+ * </pre>
+ */
+class xini_snapshot_t
+{
+    // common data types
+public:
+    typedef std::shared_ptr< const xini_file_t > xfile_sptr_t;
+
+    /**
+     * @class reader_t
+     * @brief 读线程持有的快照句柄（不可在多个线程间共享同一个对象）。
+     */
+    class reader_t
+    {
+    public:
+        explicit reader_t(const xini_snapshot_t & xsnapshot)
+            : m_xsnapshot(xsnapshot)
+            , m_xut_version(0)
+        {
+
+        }
+
+        reader_t(const reader_t &) = delete;
+        reader_t & operator = (const reader_t &) = delete;
+
+    public:
+        /**********************************************************/
+        /**
+         * @brief 返回当前快照，若已发布了新快照，则切换到新快照。
+         * @note  返回的引用在下一次调用 get() 之前一直有效。
+         */
+        const xini_file_t & get(void)
+        {
+            unsigned long long xut_version =
+                m_xsnapshot.m_xut_version.load(std::memory_order_acquire);
+            if (xut_version != m_xut_version)
+            {
+                m_xfile_sptr   = m_xsnapshot.acquire();
+                m_xut_version  = xut_version;
+            }
+
+            return *m_xfile_sptr;
+        }
+
+        inline const xini_file_t * operator -> (void) { return &get(); }
+
+        /**********************************************************/
+        /**
+         * @brief 放弃当前持有的快照（如读线程空闲前调用，便于旧快照尽早回收）。
+         */
+        inline void reset(void)
+        {
+            m_xfile_sptr.reset();
+            m_xut_version = 0;
+        }
+
+    private:
+        const xini_snapshot_t & m_xsnapshot;
+        unsigned long long      m_xut_version;  ///< 所持有快照的版本号
+        xfile_sptr_t            m_xfile_sptr;   ///< 所持有的快照
+    };
+
+    friend class reader_t;
+
+    // constructor/destructor
+public:
+    xini_snapshot_t(void)
+        : m_xut_version(0)
+    {
+        publish(std::make_shared< xini_file_t >());
+    }
+
+    explicit xini_snapshot_t(const std::string & xstr_filepath)
+        : m_xut_version(0)
+    {
+        publish(std::make_shared< xini_file_t >(xstr_filepath));
+    }
+
+    ~xini_snapshot_t(void)
+    {
+
+    }
+
+    xini_snapshot_t(const xini_snapshot_t &) = delete;
+    xini_snapshot_t & operator = (const xini_snapshot_t &) = delete;
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 获取当前快照（持有返回值期间，快照不会被回收）。
+     */
+    xfile_sptr_t acquire(void) const
+    {
+        return std::atomic_load_explicit(
+                    &m_xfile_sptr, std::memory_order_acquire);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 当前快照的版本号（每次发布递增）。
+     */
+    inline unsigned long long version(void) const
+    {
+        return m_xut_version.load(std::memory_order_acquire);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 冻结并原子发布新的快照。
+     * @note
+     *  发布后 xfile_sptr 只能以 const 方式访问，调用方不可再修改它；
+     *  其脏标识会被清除，避免快照析构时回写文件。
+     */
+    void publish(std::shared_ptr< xini_file_t > xfile_sptr)
+    {
+        assert(NULL != xfile_sptr.get());
+        xfile_sptr->set_dirty(false);
+
+        std::lock_guard< std::mutex > xlock(m_xmutex_pub);
+
+        xfile_sptr_t xfile_retired = std::atomic_exchange_explicit(
+                    &m_xfile_sptr,
+                    xfile_sptr_t(std::move(xfile_sptr)),
+                    std::memory_order_acq_rel);
+        m_xut_version.fetch_add(1, std::memory_order_release);
+
+        if (NULL != xfile_retired.get())
+        {
+            m_xvec_retired.push_back(std::move(xfile_retired));
+        }
+
+        collect_retired();
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 重新加载 INI 文件，并发布为新的快照（解析过程不持有任何锁）。
+     *
+     * @param [in ] xstr_filepath : 文件路径，为空时沿用当前快照的文件路径。
+     *
+     * @return bool : load() 操作是否成功（失败时不发布新快照）。
+     */
+    bool reload(const std::string & xstr_filepath = std::string(""))
+    {
+        std::string xstr_path = xstr_filepath;
+        if (xstr_path.empty())
+        {
+            xstr_path = acquire()->filepath();
+        }
+
+        std::shared_ptr< xini_file_t > xfile_sptr =
+                    std::make_shared< xini_file_t >();
+        if (!xfile_sptr->load(xstr_path))
+        {
+            xfile_sptr->release();
+            return false;
+        }
+
+        publish(std::move(xfile_sptr));
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 回收已无读者引用的旧快照。
+     *
+     * @return size_t : 仍在等待读者释放的旧快照数量。
+     */
+    size_t collect(void)
+    {
+        std::lock_guard< std::mutex > xlock(m_xmutex_pub);
+        return collect_retired();
+    }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 回收已无读者引用的旧快照（调用前须持有 m_xmutex_pub）。
+     * @note
+     *  旧快照已不可能再被 acquire()，use_count() == 1 即表示
+     *  只剩 m_xvec_retired 中的引用，此时可安全析构。
+     */
+    size_t collect_retired(void)
+    {
+        std::vector< xfile_sptr_t >::iterator itvec = m_xvec_retired.begin();
+        while (itvec != m_xvec_retired.end())
+        {
+            if (1 == itvec->use_count())
+                itvec = m_xvec_retired.erase(itvec);
+            else
+                ++itvec;
+        }
+
+        return m_xvec_retired.size();
+    }
+
+    // data members
+protected:
+    xfile_sptr_t                      m_xfile_sptr;    ///< 当前发布的快照
+    std::atomic< unsigned long long > m_xut_version;   ///< 当前快照的版本号
+    std::mutex                        m_xmutex_pub;    ///< 串行化 发布/回收 操作
+    std::vector< xfile_sptr_t >       m_xvec_retired;  ///< 等待回收的旧快照
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XINI_SHARED_H__
@@ -0,0 +1,294 @@
+﻿/**
+ * The MIT License (MIT)
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file xini_tpool.h
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * @author  ：Gaaagaa
+ * @date    : 2026-10-19
+ * @version : 1.0.0.0
+ * @brief   : 并行操作（查询、包含文件解析 等）所使用的常驻线程池（需要 C++14 及以上版本）。
+ */
+
+
+#ifndef __XINI_TPOOL_H__
+#define __XINI_TPOOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+// xini_tpool_t
+
+/**
+ * @class xini_tpool_t
+ * @brief 常驻线程池，以 parallel_for() 的形式分发任务。
+ *
+ * <pre>
+ * 任务以 [0, count) 的索引表示，各个工作线程（包括调用线程自身）
+ * 通过原子计数器逐个领取索引，直至全部完成，调用方再返回；
+ * 工作线程在两次任务之间阻塞等待，不会空转。
+ * 多个线程可同时调用 parallel_for()：每次调用为一组任务，加入任务队列，
+ * 空闲的工作线程从队首的任务组领取索引；调用线程始终参与执行自己的任务组，
+ * 因此即使工作线程都在忙，各组任务也都能完成。
+ * 任务函数抛出的异常，在工作线程中捕获，由 parallel_for() 在调用线程中重新抛出。
+ *
+ * 使用示例：
+ *  xini_tpool_t::instance().parallel_for(xvec.size(),
+ *      [&](size_t xst_index) { ... xvec[xst_index] ... });
+ * </pre>
+ */
+class xini_tpool_t
+{
+    // common data types
+protected:
+    struct xjob_t;
+    typedef std::list< xjob_t * > xlst_job_t;
+
+    /**
+     * @struct xjob_t
+     * @brief 一次 parallel_for() 调用的任务组（位于调用线程的栈上）。
+     */
+    struct xjob_t
+    {
+        const std::function< void (size_t) > & m_xfunc_task; ///< 任务函数
+        size_t                m_xst_count;  ///< 任务数量
+        std::atomic< size_t > m_xst_next;   ///< 下一个待领取的任务索引
+        size_t                m_xst_active; ///< 正在执行该组任务的工作线程数（受 m_xmutex_job 保护）
+        std::exception_ptr    m_xexcept;    ///< 首个任务异常（受 m_xmutex_job 保护）
+        bool                  m_xbt_queued; ///< 是否仍在任务队列中（受 m_xmutex_job 保护）
+        xlst_job_t::iterator  m_xiter_job;  ///< 在任务队列中的位置
+
+        xjob_t(const std::function< void (size_t) > & xfunc_task, size_t xst_count)
+            : m_xfunc_task(xfunc_task)
+            , m_xst_count(xst_count)
+            , m_xst_next(0)
+            , m_xst_active(0)
+            , m_xbt_queued(false)
+        {
+
+        }
+    };
+
+    // constructor/destructor
+public:
+    /**********************************************************/
+    /**
+     * @brief 构造函数。
+     * 
+     * @param [in ] xst_threads : 并行度（含调用线程），为 0 时取 CPU 核心数。
+     */
+    explicit xini_tpool_t(size_t xst_threads = 0)
+        : m_xbt_quit(false)
+    {
+        if (0 == xst_threads)
+        {
+            xst_threads = std::thread::hardware_concurrency();
+        }
+
+        for (size_t xst_iter = 1; xst_iter < xst_threads; ++xst_iter)
+        {
+            m_xvec_thread.emplace_back(&xini_tpool_t::thread_proc, this);
+        }
+    }
+
+    ~xini_tpool_t(void)
+    {
+        {
+            std::lock_guard< std::mutex > xlock(m_xmutex_job);
+            m_xbt_quit = true;
+        }
+        m_xcond_job.notify_all();
+
+        for (std::vector< std::thread >::iterator
+                itvec  = m_xvec_thread.begin();
+                itvec != m_xvec_thread.end();
+                ++itvec)
+        {
+            itvec->join();
+        }
+    }
+
+    xini_tpool_t(const xini_tpool_t &) = delete;
+    xini_tpool_t & operator = (const xini_tpool_t &) = delete;
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 进程内共享的线程池（并行度为 CPU 核心数）。
+     */
+    static xini_tpool_t & instance(void)
+    {
+        static xini_tpool_t xtpool;
+        return xtpool;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 并行度（工作线程数 + 调用线程）。
+     */
+    inline size_t size(void) const
+    {
+        return (m_xvec_thread.size() + 1);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 并行执行 xfunc_task(0) ... xfunc_task(xst_count - 1)，全部完成后返回。
+     * @note
+     *  各个索引的执行次序不确定；某个索引抛出异常后，尚未领取的索引不再执行，
+     *  待已领取的索引执行完毕，在调用线程中重新抛出首个异常。
+     * 
+     * @param [in ] xst_count  : 任务数量。
+     * @param [in ] xfunc_task : 任务函数，原型为 void (size_t)。
+     */
+    void parallel_for(size_t xst_count, const std::function< void (size_t) > & xfunc_task)
+    {
+        if ((xst_count <= 1) || m_xvec_thread.empty())
+        {
+            for (size_t xst_iter = 0; xst_iter < xst_count; ++xst_iter)
+                xfunc_task(xst_iter);
+            return;
+        }
+
+        xjob_t xjob(xfunc_task, xst_count);
+
+        {
+            std::lock_guard< std::mutex > xlock(m_xmutex_job);
+            xjob.m_xiter_job  = m_xlst_job.insert(m_xlst_job.end(), &xjob);
+            xjob.m_xbt_queued = true;
+        }
+        m_xcond_job.notify_all();
+
+        run_tasks(xjob);
+
+        //======================================
+        // 移出队列（不再有工作线程加入），等待已加入的工作线程完成
+
+        std::unique_lock< std::mutex > xlock(m_xmutex_job);
+        unlink_job(xjob);
+        m_xcond_done.wait(xlock, [&xjob]() { return (0 == xjob.m_xst_active); });
+
+        if (xjob.m_xexcept)
+        {
+            std::rethrow_exception(xjob.m_xexcept);
+        }
+    }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 逐个领取任务索引并执行，直至领取完毕（或有任务抛出异常）。
+     */
+    void run_tasks(xjob_t & xjob)
+    {
+        size_t xst_index = 0;
+        while ((xst_index = xjob.m_xst_next.fetch_add(1, std::memory_order_relaxed)) < xjob.m_xst_count)
+        {
+            try
+            {
+                xjob.m_xfunc_task(xst_index);
+            }
+            catch (...)
+            {
+                {
+                    std::lock_guard< std::mutex > xlock(m_xmutex_job);
+                    if (!xjob.m_xexcept)
+                        xjob.m_xexcept = std::current_exception();
+                }
+
+                // 跳过其余未领取的索引
+                xjob.m_xst_next.store(xjob.m_xst_count, std::memory_order_relaxed);
+                break;
+            }
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 将（索引已领取完毕的）任务组移出队列，已移出的则忽略（调用方需持有 m_xmutex_job）。
+     */
+    inline void unlink_job(xjob_t & xjob)
+    {
+        if (xjob.m_xbt_queued)
+        {
+            m_xlst_job.erase(xjob.m_xiter_job);
+            xjob.m_xbt_queued = false;
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 工作线程的执行流程。
+     */
+    void thread_proc(void)
+    {
+        std::unique_lock< std::mutex > xlock(m_xmutex_job);
+
+        for (;;)
+        {
+            m_xcond_job.wait(xlock,
+                [this]() { return (m_xbt_quit || !m_xlst_job.empty()); });
+            if (m_xbt_quit)
+                break;
+
+            xjob_t * xjob_ptr = m_xlst_job.front();
+            ++xjob_ptr->m_xst_active;
+            xlock.unlock();
+
+            run_tasks(*xjob_ptr);
+
+            xlock.lock();
+
+            // 索引已领取完毕，移出队列，其他空闲线程转向下一组任务
+            unlink_job(*xjob_ptr);
+
+            if (0 == --xjob_ptr->m_xst_active)
+            {
+                m_xcond_done.notify_all();
+            }
+        }
+    }
+
+    // data members
+protected:
+    std::vector< std::thread > m_xvec_thread;  ///< 工作线程
+
+    std::mutex                 m_xmutex_job;   ///< 保护 任务队列 以及 任务组中的 活动线程数、异常
+    std::condition_variable    m_xcond_job;    ///< 通知工作线程 有新任务 或 退出
+    std::condition_variable    m_xcond_done;   ///< 通知调用线程 工作线程已退出其任务组
+    bool                       m_xbt_quit;     ///< 退出标识
+    xlst_job_t                 m_xlst_job;     ///< 任务队列（尚有索引未领取的任务组）
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XINI_TPOOL_H__
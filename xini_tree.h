@@ -0,0 +1,379 @@
+﻿/**
+ * The MIT License (MIT)
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file xini_tree.h
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * @author  ：Gaaagaa
+ * @date    : 2026-10-19
+ * @version : 1.0.0.0
+ * @brief   : 以点号分隔的分节名（如 [a.b.c]）构建的分节树索引，支持键值继承查找。
+ */
+
+#ifndef __XINI_TREE_H__
+#define __XINI_TREE_H__
+
+#include "xini_file.h"
+
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+// xini_tree_t
+
+/**
+ * @class xini_tree_t
+ * @brief 分节树：按分隔符（默认为 '.'）拆分分节名，建立 父分节 -> 子分节 的索引。
+ *
+ * <pre>
+ * 保存的是 xini_file_t 的克隆对象（写时复制，不复制键值），之后对原对象的修改不影响索引，
+ * 原对象修改后，可调用 build() 重建索引。
+ * 分节名 “a.b.c” 的各级父节点（“a.b”、“a”）即使文件中没有对应的分节，
+ * 也会作为 隐含节点 加入树中，以便逐级遍历；树的根节点为 无名分节。
+ * 
+ * 继承查找（find() 的 xbt_inherit 参数为 true）：当前分节中没有该键值时，
+ * 依次到 父分节、祖父分节……中查找（不包括 无名分节）。查找时沿父节点逐级上溯
+ * （层数 即 分节名中的分隔符数量），不额外占用内存；只读访问，可被多个线程并发调用，无需加锁。
+ *
+ * 使用示例：
+ *  xini_tree_t xtree(xini_file);
+ *  xtree.children("server", visitor);  // 枚举 [server.xxx] 形式的直接子分节
+ *  int port = xtree("server.eu.fra", "port", true);
+ * </pre>
+ */
+class xini_tree_t
+{
+    // common data types
+protected:
+    /**
+     * @struct xtnode_t
+     * @brief  分节树的节点。
+     */
+    struct xtnode_t
+    {
+        std::string              m_xstr_path;    ///< 完整的分节名（以第一次出现时的写法为准）
+        const xini_section_t   * m_xsect_ptr;    ///< 对应的分节（隐含节点为 NULL）
+        xtnode_t               * m_xparent_ptr;  ///< 父节点（根节点为 NULL）
+        std::vector< xtnode_t * > m_xvec_child;  ///< 子节点（按分节在文件中出现的顺序）
+
+        xtnode_t(void) : m_xsect_ptr(NULL), m_xparent_ptr(NULL) { }
+    };
+
+    typedef std::map< std::string, xtnode_t > xmap_tnode_t;
+
+    // constructor/destructor
+public:
+    explicit xini_tree_t(char xch_delim = '.')
+        : m_xch_delim(xch_delim)
+    {
+        m_xini_file.set_dirty(false);
+    }
+
+    explicit xini_tree_t(const xini_file_t & xini_file, char xch_delim = '.')
+        : m_xch_delim(xch_delim)
+    {
+        build(xini_file);
+    }
+
+    ~xini_tree_t(void)
+    {
+
+    }
+
+private:
+    // 禁用 拷贝构造 和 赋值 操作（树节点之间以指针相连）
+    xini_tree_t(const xini_tree_t &);
+    xini_tree_t & operator = (const xini_tree_t &);
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 建立（重建）分节树索引。
+     * 
+     * @param [in ] xini_file : 配置对象（保存其克隆对象）。
+     */
+    void build(const xini_file_t & xini_file)
+    {
+        m_xmap_tnode.clear();
+
+        // 克隆对象只用于读取，清除脏标识，避免析构时回写文件
+        m_xini_file = xini_file;
+        m_xini_file.set_dirty(false);
+
+        // 树节点直接记录 克隆对象 中的分节（只经由 const 接口访问），
+        // 源对象 的写入 不会波及这些分节（参看 xini_node_t::is_writable()）
+        const xini_file_t & xfile_cref = m_xini_file;
+        for (xini_file_t::const_iterator
+                itsect  = xfile_cref.begin();
+                itsect != xfile_cref.end();
+                ++itsect)
+        {
+            touch_node((*itsect)->name())->m_xsect_ptr = *itsect;
+        }
+
+        // 根节点（无名分节）总是存在
+        touch_node(std::string());
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 分节路径的分隔符。
+     */
+    inline char delim(void) const { return m_xch_delim; }
+
+    /**********************************************************/
+    /**
+     * @brief 树节点数量（含 根节点 与 隐含节点）。
+     */
+    inline size_t size(void) const { return m_xmap_tnode.size(); }
+
+    /**********************************************************/
+    /**
+     * @brief 索引所使用的配置对象（克隆对象）。
+     */
+    inline const xini_file_t & file(void) const { return m_xini_file; }
+
+    /**********************************************************/
+    /**
+     * @brief 判断树中是否存在指定的节点（包括 隐含节点）。
+     */
+    inline bool exists(const std::string & xstr_path) const
+    {
+        return (NULL != find_node(xstr_path));
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 返回节点对应的分节，节点不存在 或 为隐含节点 时，返回 NULL 。
+     */
+    const xini_section_t * section(const std::string & xstr_path) const
+    {
+        const xtnode_t * xnode_ptr = find_node(xstr_path);
+        return (NULL != xnode_ptr) ? xnode_ptr->m_xsect_ptr : NULL;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 返回父节点的完整分节名（顶层节点的父节点为 无名分节）。
+     * 
+     * @return bool : 节点不存在 或 为根节点 时，返回 false 。
+     */
+    bool parent(const std::string & xstr_path, std::string & xstr_parent) const
+    {
+        const xtnode_t * xnode_ptr = find_node(xstr_path);
+        if ((NULL == xnode_ptr) || (NULL == xnode_ptr->m_xparent_ptr))
+        {
+            return false;
+        }
+
+        xstr_parent = xnode_ptr->m_xparent_ptr->m_xstr_path;
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 枚举直接子节点（无需扫描全部分节）。
+     * 
+     * @param [in ] xstr_path   : 父节点的分节名（空串表示根节点，即枚举顶层节点）。
+     * @param [in ] xfunc_visit : 访问函数（对象），原型为
+     *                            void (const std::string & xstr_path, const xini_section_t * xsect_ptr)，
+     *                            隐含节点的 xsect_ptr 为 NULL；按分节在文件中出现的顺序依次回调。
+     * 
+     * @return size_t : 子节点数量。
+     */
+    template< typename __func_type >
+    size_t children(const std::string & xstr_path, __func_type xfunc_visit) const
+    {
+        const xtnode_t * xnode_ptr = find_node(xstr_path);
+        if (NULL == xnode_ptr)
+        {
+            return 0;
+        }
+
+        for (std::vector< xtnode_t * >::const_iterator
+                itvec  = xnode_ptr->m_xvec_child.begin();
+                itvec != xnode_ptr->m_xvec_child.end();
+                ++itvec)
+        {
+            xfunc_visit((*itvec)->m_xstr_path, (*itvec)->m_xsect_ptr);
+        }
+
+        return xnode_ptr->m_xvec_child.size();
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 查找键值。
+     * 
+     * @param [in ] xstr_path   : 分节名。
+     * @param [in ] xstr_key    : 键名。
+     * @param [in ] xbt_inherit : 是否继承查找（逐级到父分节中查找）。
+     * 
+     * @return const xini_keyvalue_t * : 不存在时返回 NULL 。
+     */
+    const xini_keyvalue_t * find(const std::string & xstr_path,
+                                 const std::string & xstr_key,
+                                 bool xbt_inherit = false) const
+    {
+        const xtnode_t * xnode_ptr = find_node(xstr_path);
+        if (NULL == xnode_ptr)
+        {
+            return NULL;
+        }
+
+        if (!xbt_inherit)
+        {
+            return find_in(xnode_ptr, xstr_key);
+        }
+
+        // 逐级到父分节中查找，根节点（无名分节）不参与继承
+        for (; NULL != xnode_ptr->m_xparent_ptr; xnode_ptr = xnode_ptr->m_xparent_ptr)
+        {
+            const xini_keyvalue_t * xndkv_ptr = find_in(xnode_ptr, xstr_key);
+            if (NULL != xndkv_ptr)
+            {
+                return xndkv_ptr;
+            }
+        }
+
+        return NULL;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 只读索引操作，不存在时返回空键值节点，
+     *        可直接转换为 基础数据类型，如 int port = xtree("server.eu", "port", true); 。
+     */
+    const xini_keyvalue_t & operator () (const std::string & xstr_path,
+                                         const std::string & xstr_key,
+                                         bool xbt_inherit = false) const
+    {
+        const xini_keyvalue_t * xndkv_ptr = find(xstr_path, xstr_key, xbt_inherit);
+        if (NULL != xndkv_ptr)
+        {
+            return *xndkv_ptr;
+        }
+
+        static const xini_file_t xnil_file;
+        return xnil_file[std::string()][std::string()];
+    }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 修剪字符串前后端的字符集（与 xini_file_t 中 分节名/键名 的修剪规则一致）。
+     */
+    static std::string trim_name(const std::string & xstr, const char * xchars)
+    {
+        std::string::size_type xst_pos = xstr.find_first_not_of(xchars);
+        if (std::string::npos == xst_pos)
+        {
+            return std::string();
+        }
+
+        return xstr.substr(xst_pos, xstr.find_last_not_of(xchars) - xst_pos + 1);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 转为小写（与 xstr_icmp() 一致），作为索引名。
+     */
+    static std::string fold_name(std::string xstr_name)
+    {
+        for (std::string::iterator
+                itstr  = xstr_name.begin();
+                itstr != xstr_name.end();
+                ++itstr)
+        {
+            if ((*itstr >= 'A') && (*itstr <= 'Z'))
+                *itstr += ('a' - 'A');
+        }
+
+        return xstr_name;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 查找树节点。
+     */
+    const xtnode_t * find_node(const std::string & xstr_path) const
+    {
+        xmap_tnode_t::const_iterator itmap =
+            m_xmap_tnode.find(fold_name(trim_name(xstr_path, "[] \t\n\r\f\v")));
+        return (itmap != m_xmap_tnode.end()) ? &itmap->second : NULL;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 在树节点对应的分节中查找键值。
+     */
+    static const xini_keyvalue_t * find_in(const xtnode_t * xnode_ptr,
+                                           const std::string & xstr_key)
+    {
+        const xini_section_t * xsect_ptr = xnode_ptr->m_xsect_ptr;
+        if ((NULL == xsect_ptr) || !xsect_ptr->key_included(xstr_key))
+        {
+            return NULL;
+        }
+
+        return &(*xsect_ptr)[xstr_key];
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 获取（不存在时创建）树节点，并逐级建立其父节点。
+     */
+    xtnode_t * touch_node(const std::string & xstr_path)
+    {
+        std::pair< xmap_tnode_t::iterator, bool > xpair =
+            m_xmap_tnode.insert(std::make_pair(fold_name(xstr_path), xtnode_t()));
+
+        xtnode_t * xnode_ptr = &xpair.first->second;
+        if (!xpair.second || xstr_path.empty())
+        {
+            return xnode_ptr;
+        }
+
+        xnode_ptr->m_xstr_path = xstr_path;
+
+        std::string::size_type xst_pos = xstr_path.rfind(m_xch_delim);
+        xtnode_t * xparent_ptr =
+            touch_node((std::string::npos == xst_pos) ? std::string() : xstr_path.substr(0, xst_pos));
+
+        xnode_ptr->m_xparent_ptr = xparent_ptr;
+        xparent_ptr->m_xvec_child.push_back(xnode_ptr);
+
+        return xnode_ptr;
+    }
+
+    // data members
+protected:
+    char                   m_xch_delim;     ///< 分节路径的分隔符
+    xini_file_t            m_xini_file;     ///< 克隆对象（写时复制）
+    xmap_tnode_t           m_xmap_tnode;    ///< 树节点表（索引名 -> 树节点）
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XINI_TREE_H__
@@ -0,0 +1,421 @@
+﻿/**
+ * The MIT License (MIT)
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file xini_watch.h
+ * Copyright (c) 2019-2026, Gaaagaa All rights reserved.
+ *
+ * @author  ：Gaaagaa
+ * @date    : 2026-10-19
+ * @version : 1.0.0.0
+ * @brief   : 基于 inotify 的 INI 文件监视与自动重新加载（仅 Linux 平台）。
+ */
+
+#ifndef __XINI_WATCH_H__
+#define __XINI_WATCH_H__
+
+#include "xini_shared.h"
+
+#ifdef __linux__
+
+#include <functional>
+#include <sstream>
+#include <thread>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// xini_watch_t
+
+/**
+ * @class xini_watch_t
+ * @brief 监视 xini_snapshot_t 当前快照所关联的 INI 文件，文件变更时自动重新加载。
+ *
+ * <pre>
+ * 1. 监视的是 文件所在目录 的 IN_CLOSE_WRITE/IN_MOVED_TO 事件（按文件名过滤），
+ *    这样编辑器以 “写临时文件 + rename” 方式保存时，也能收到通知；
+ * 2. 收到通知后，读取文件内容并计算摘要（FNV-1a 64），
+ *    仅在摘要变化时才解析并发布新快照，避免无意义的重新解析；
+ * 3. 新快照发布后，依次回调各个订阅者（在监视线程中执行）。
+ *
+ * 使用示例：
+ *  xini_snapshot_t xini_snapshot("test.ini");
+ *  xini_watch_t    xini_watch(xini_snapshot);
+ *  xini_watch.subscribe([](const xini_snapshot_t::xfile_sptr_t & xfile_sptr) { ... });
+ *  xini_watch.start();
+ * </pre>
+ */
+class xini_watch_t
+{
+    // common data types
+public:
+    typedef std::function< void(const xini_snapshot_t::xfile_sptr_t &) > xfunc_notify_t;
+
+protected:
+    typedef std::vector< std::pair< size_t, xfunc_notify_t > > xvec_notify_t;
+
+    // common invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 计算内容摘要（FNV-1a 64）。
+     */
+    static unsigned long long xhash_text(const std::string & xstr_text)
+    {
+        unsigned long long xut_hash = 0xCBF29CE484222325ULL;
+        for (std::string::size_type xst_iter = 0; xst_iter < xstr_text.size(); ++xst_iter)
+        {
+            xut_hash ^= static_cast< unsigned char >(xstr_text[xst_iter]);
+            xut_hash *= 0x00000100000001B3ULL;
+        }
+
+        return xut_hash;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 读取文件的全部内容。
+     */
+    static bool read_text(const std::string & xstr_filepath, std::string & xstr_text)
+    {
+        std::ifstream xfile_reader(xstr_filepath.c_str(), std::ios_base::binary);
+        if (!xfile_reader.is_open())
+        {
+            return false;
+        }
+
+        std::ostringstream ostr;
+        ostr << xfile_reader.rdbuf();
+        xstr_text = ostr.str();
+
+        return true;
+    }
+
+    // constructor/destructor
+public:
+    explicit xini_watch_t(xini_snapshot_t & xsnapshot)
+        : m_xsnapshot(xsnapshot)
+        , m_xut_hash(0)
+        , m_xfd_notify(-1)
+        , m_xst_nextid(0)
+    {
+        m_xfd_pipe[0] = -1;
+        m_xfd_pipe[1] = -1;
+    }
+
+    ~xini_watch_t(void)
+    {
+        stop();
+    }
+
+    xini_watch_t(const xini_watch_t &) = delete;
+    xini_watch_t & operator = (const xini_watch_t &) = delete;
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 启动监视线程。
+     *
+     * @param [in ] xstr_filepath : 监视的文件路径，为空时取当前快照的 filepath() 。
+     *
+     * @return bool : 操作是否成功。
+     */
+    bool start(const std::string & xstr_filepath = std::string(""))
+    {
+        if (m_xthread.joinable())
+        {
+            return false;
+        }
+
+        m_xstr_path = xstr_filepath;
+        if (m_xstr_path.empty())
+        {
+            m_xstr_path = m_xsnapshot.acquire()->filepath();
+        }
+
+        if (m_xstr_path.empty())
+        {
+            return false;
+        }
+
+        //======================================
+        // 拆分 目录 与 文件名
+
+        std::string::size_type xst_pos = m_xstr_path.find_last_of('/');
+        std::string xstr_dir  = ".";
+        m_xstr_name = m_xstr_path;
+        if (std::string::npos != xst_pos)
+        {
+            xstr_dir    = (0 == xst_pos) ? std::string("/") : m_xstr_path.substr(0, xst_pos);
+            m_xstr_name = m_xstr_path.substr(xst_pos + 1);
+        }
+
+        //======================================
+
+        m_xfd_notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (-1 == m_xfd_notify)
+        {
+            return false;
+        }
+
+        if (-1 == inotify_add_watch(m_xfd_notify,
+                                    xstr_dir.c_str(),
+                                    IN_CLOSE_WRITE | IN_MOVED_TO))
+        {
+            close_fds();
+            return false;
+        }
+
+        if (0 != pipe2(m_xfd_pipe, O_NONBLOCK | O_CLOEXEC))
+        {
+            close_fds();
+            return false;
+        }
+
+        // 以当前文件内容的摘要作为比对基准
+        std::string xstr_text;
+        m_xut_hash = read_text(m_xstr_path, xstr_text) ? xhash_text(xstr_text) : 0;
+
+        m_xthread = std::thread(&xini_watch_t::thread_run, this);
+
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 停止监视线程。
+     */
+    void stop(void)
+    {
+        if (m_xthread.joinable())
+        {
+            char xchar = 0;
+            while ((-1 == write(m_xfd_pipe[1], &xchar, 1)) && (EINTR == errno))
+            {
+            }
+
+            m_xthread.join();
+        }
+
+        close_fds();
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 添加订阅者（新快照发布后回调）。
+     *
+     * @return size_t : 订阅标识，用于 unsubscribe() 。
+     */
+    size_t subscribe(const xfunc_notify_t & xfunc_notify)
+    {
+        std::lock_guard< std::mutex > xlock(m_xmutex_notify);
+        m_xvec_notify.push_back(std::make_pair(++m_xst_nextid, xfunc_notify));
+        return m_xst_nextid;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 移除订阅者。
+     */
+    void unsubscribe(size_t xst_id)
+    {
+        std::lock_guard< std::mutex > xlock(m_xmutex_notify);
+        for (xvec_notify_t::iterator itvec = m_xvec_notify.begin();
+             itvec != m_xvec_notify.end();
+             ++itvec)
+        {
+            if (xst_id == itvec->first)
+            {
+                m_xvec_notify.erase(itvec);
+                break;
+            }
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 检查文件内容，若有变化则重新加载、发布新快照，并通知订阅者。
+     * @note  通常由监视线程调用，也可由外部主动调用（须保证不与监视线程并发）。
+     *
+     * @return bool : 是否发布了新快照。
+     */
+    bool check(void)
+    {
+        std::string xstr_text;
+        if (!read_text(m_xstr_path, xstr_text))
+        {
+            return false;
+        }
+
+        unsigned long long xut_hash = xhash_text(xstr_text);
+        if (xut_hash == m_xut_hash)
+        {
+            return false;
+        }
+
+        std::istringstream istr(xstr_text);
+        std::shared_ptr< xini_file_t > xfile_sptr = std::make_shared< xini_file_t >();
+        xfile_sptr->load(istr, m_xstr_path);
+
+        m_xsnapshot.publish(xfile_sptr);
+        m_xut_hash = xut_hash;
+
+        //======================================
+        // 通知订阅者（复制一份订阅表，回调中可以调用 subscribe/unsubscribe）
+
+        xvec_notify_t xvec_notify;
+        {
+            std::lock_guard< std::mutex > xlock(m_xmutex_notify);
+            xvec_notify = m_xvec_notify;
+        }
+
+        xini_snapshot_t::xfile_sptr_t xfile_cptr = xfile_sptr;
+        for (xvec_notify_t::iterator itvec = xvec_notify.begin();
+             itvec != xvec_notify.end();
+             ++itvec)
+        {
+            itvec->second(xfile_cptr);
+        }
+
+        return true;
+    }
+
+    // inner invoking
+protected:
+    /**********************************************************/
+    /**
+     * @brief 监视线程的执行流程。
+     */
+    void thread_run(void)
+    {
+        char xbuffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+        for (;;)
+        {
+            struct pollfd xfds[2];
+            xfds[0].fd     = m_xfd_notify;
+            xfds[0].events = POLLIN;
+            xfds[1].fd     = m_xfd_pipe[0];
+            xfds[1].events = POLLIN;
+
+            int xit_ready = poll(xfds, 2, -1);
+            if (xit_ready < 0)
+            {
+                if (EINTR == errno)
+                    continue;
+                break;
+            }
+
+            // 收到停止通知
+            if (0 != (xfds[1].revents & POLLIN))
+            {
+                break;
+            }
+
+            if (0 == (xfds[0].revents & POLLIN))
+            {
+                continue;
+            }
+
+            //======================================
+            // 读取全部事件，只要有一个事件与监视文件相关，就检查一次
+
+            bool xbt_changed = false;
+            for (;;)
+            {
+                ssize_t xst_size = read(m_xfd_notify, xbuffer, sizeof(xbuffer));
+                if (xst_size <= 0)
+                {
+                    break;
+                }
+
+                for (char * xptr = xbuffer; xptr < xbuffer + xst_size; )
+                {
+                    const struct inotify_event * xevent_ptr =
+                        reinterpret_cast< const struct inotify_event * >(xptr);
+
+                    if ((xevent_ptr->len > 0) &&
+                        (m_xstr_name == xevent_ptr->name))
+                    {
+                        xbt_changed = true;
+                    }
+
+                    xptr += sizeof(struct inotify_event) + xevent_ptr->len;
+                }
+            }
+
+            if (xbt_changed)
+            {
+                check();
+            }
+
+            //======================================
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 关闭所有描述符。
+     */
+    void close_fds(void)
+    {
+        if (-1 != m_xfd_notify)
+        {
+            close(m_xfd_notify);
+            m_xfd_notify = -1;
+        }
+
+        for (int xit_iter = 0; xit_iter < 2; ++xit_iter)
+        {
+            if (-1 != m_xfd_pipe[xit_iter])
+            {
+                close(m_xfd_pipe[xit_iter]);
+                m_xfd_pipe[xit_iter] = -1;
+            }
+        }
+    }
+
+    // data members
+protected:
+    xini_snapshot_t  & m_xsnapshot;      ///< 发布新快照的目标
+    std::string        m_xstr_path;      ///< 监视的文件路径
+    std::string        m_xstr_name;      ///< 监视的文件名（用于过滤目录事件）
+    unsigned long long m_xut_hash;       ///< 最近一次加载的文件内容摘要
+    int                m_xfd_notify;     ///< inotify 描述符
+    int                m_xfd_pipe[2];    ///< 用于通知监视线程退出的管道
+    std::thread        m_xthread;        ///< 监视线程
+
+    std::mutex         m_xmutex_notify;  ///< 订阅表的互斥锁
+    xvec_notify_t      m_xvec_notify;    ///< 订阅表
+    size_t             m_xst_nextid;     ///< 订阅标识的分配计数
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __linux__
+
+#endif // __XINI_WATCH_H__